@@ -1,8 +1,6 @@
 #pragma once
 #include <cstdint>
 #include <span>
-#include <type_traits>
-#include <sph/hash_algorithm.h>
 
 namespace sph
 {
@@ -13,11 +11,3 @@ namespace sph
         std::span<uint8_t const> personal{};
     };
 }
-
-namespace sph::ranges::views::detail
-{
-    struct no_algorithm_parameters {};
-
-    template <sph::hash_algorithm A>
-    using algorithm_parameters_t = std::conditional_t<A == sph::hash_algorithm::blake2b, sph::blake2b_parameters, no_algorithm_parameters>;
-}
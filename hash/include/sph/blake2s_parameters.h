@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace sph
+{
+    /**
+     * @brief Parameters for hash_algorithm::blake2s.
+     *
+     * The key may be 0 to 32 bytes; salt and personalization must each be
+     * empty or exactly 8 bytes.
+     */
+    struct blake2s_parameters
+    {
+        std::span<uint8_t const> key{};
+        std::span<uint8_t const> salt{};
+        std::span<uint8_t const> personal{};
+    };
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_format.h>
+#include <sph/hash_param.h>
+#include <sph/hash_site.h>
+#include <sph/hasher.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/get_hash_size.h>
+#include <sph/ranges/views/detail/hash_util.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * A contiguous, sized range whose elements can be copied and hashed as
+     * their bytes.
+     */
+    template <typename R>
+    concept copy_hash_range = std::ranges::contiguous_range<R>
+        && std::ranges::sized_range<R>
+        && hashable_type<std::remove_cvref_t<std::ranges::range_value_t<R>>>;
+
+    template<copy_hash_range R>
+    auto range_bytes(R const& input) -> std::span<uint8_t const>
+    {
+        auto const count{ static_cast<size_t>(std::ranges::size(input)) * sizeof(std::ranges::range_value_t<R>) };
+        if (count == 0)
+        {
+            return {};
+        }
+
+        return { reinterpret_cast<uint8_t const*>(std::ranges::data(input)), count };
+    }
+
+    /**
+     * Make a hasher for a message of object_size bytes.
+     */
+    template<sph::hash_algorithm A, typename... P>
+    auto make_hasher(size_t target_hash_size, uint64_t object_size, P const&... parameters) -> sph::hasher<A>
+    {
+        if constexpr (sph::hash_param<A>::git_object())
+        {
+            return sph::hasher<A>{ object_size, target_hash_size, parameters... };
+        }
+        else
+        {
+            return sph::hasher<A>{ target_hash_size, parameters... };
+        }
+    }
+
+    /**
+     * Copy the input a block at a time and hash each block from the
+     * destination right after it is written, while it is still in cache.
+     * Hashing the copy rather than the source also means the digest is of
+     * exactly the bytes written, even if the source changes underneath.
+     */
+    template<sph::hash_algorithm A>
+    auto copy_hash_blocks(std::span<uint8_t const> input, std::span<uint8_t> output, sph::hasher<A>& hasher) -> void
+    {
+        constexpr size_t block_size{ sph::hash_param<A>::copy_block_size() };
+        for (size_t offset = 0; offset < input.size(); offset += block_size)
+        {
+            auto const size{ std::min(block_size, input.size() - offset) };
+            std::memcpy(output.data() + offset, input.data() + offset, size);
+            hasher.update(output.subspan(offset, size));
+        }
+    }
+
+    template<sph::hash_algorithm A, typename... P>
+    auto copy_hash_separate(std::span<uint8_t const> input, std::span<uint8_t> output, std::span<uint8_t> digest, P const&... parameters) -> size_t
+    {
+        if (output.size() < input.size())
+        {
+            throw std::invalid_argument(std::format("Output buffer of {} bytes is too small for {} bytes.", output.size(), input.size()));
+        }
+
+        if (digest.empty())
+        {
+            throw std::invalid_argument("The digest buffer is empty.");
+        }
+
+        auto hasher{ make_hasher<A>(digest.size(), input.size(), parameters...) };
+        copy_hash_blocks(input, output, hasher);
+        hasher.finalize_into(digest);
+        return input.size();
+    }
+
+    template<sph::hash_algorithm A, typename... P>
+    auto copy_hash_append(std::span<uint8_t const> input, std::span<uint8_t> output, size_t target_hash_size, P const&... parameters) -> size_t
+    {
+        auto const digest_size{ get_hash_size<A, sph::hash_format::raw, sph::hash_site::append>(target_hash_size) };
+        if (output.size() < input.size() + digest_size)
+        {
+            throw std::invalid_argument(std::format("Output buffer of {} bytes is too small for {} bytes and a {} byte hash.", output.size(), input.size(), digest_size));
+        }
+
+        auto hasher{ make_hasher<A>(digest_size, input.size(), parameters...) };
+        copy_hash_blocks(input, output, hasher);
+        hasher.finalize_into(output.subspan(input.size(), digest_size));
+        return input.size() + digest_size;
+    }
+}
+
+namespace sph
+{
+    /**
+     * Copy a contiguous input into an output buffer and hash it in the same
+     * pass, e.g. a user buffer into an I/O buffer along with its checksum.
+     *
+     * The input is copied a block of
+     * <code>sph::hash_param<A>::copy_block_size()</code> bytes at a time,
+     * and each block is hashed as soon as it is copied, while it is still in
+     * cache, so the data is only read from memory once. The digest is the
+     * same bytes as <code>input | sph::views::hash<A>(digest.size())</code>.
+     *
+     * @tparam A The hash algorithm to use.
+     * @param input The elements to copy, as their bytes.
+     * @param output Where to copy them; it must not overlap the input.
+     * @param digest Where to write the digest; its size is the hash size.
+     * @return the number of bytes written to output. Throws
+     *      <code>std::invalid_argument</code>, before writing anything, if
+     *      output is too small or the digest size isn't valid.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::copy_hash_range R>
+    auto copy_hash(R const& input, std::span<uint8_t> output, std::span<uint8_t> digest) -> size_t
+    {
+        return sph::ranges::views::detail::copy_hash_separate<A>(sph::ranges::views::detail::range_bytes(input), output, digest);
+    }
+
+    template<sph::hash_algorithm A, sph::ranges::views::detail::copy_hash_range R>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto copy_hash(R const& input, std::span<uint8_t> output, std::span<uint8_t> digest, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> size_t
+    {
+        return sph::ranges::views::detail::copy_hash_separate<A>(sph::ranges::views::detail::range_bytes(input), output, digest, parameters);
+    }
+
+    /**
+     * Copy a contiguous input into an output buffer with its hash written
+     * right after it, e.g. <code>sph::copy_hash<A, sph::hash_site::append>(payload, buffer)</code>.
+     *
+     * The output holds the same bytes as
+     * <code>input | sph::views::hash<A, sph::hash_site::append>(target_hash_size)</code>.
+     *
+     * @tparam A The hash algorithm to use.
+     * @tparam S sph::hash_site::append.
+     * @param input The elements to copy, as their bytes.
+     * @param output Where to copy them and then the hash; it must not
+     *      overlap the input.
+     * @param target_hash_size The size in bytes of the hash; zero for
+     *      <code>sph::hash_param<A>::hash_byte_count()</code>.
+     * @return the number of bytes written to output, payload and hash.
+     */
+    template<sph::hash_algorithm A, sph::hash_site S, sph::ranges::views::detail::copy_hash_range R>
+        requires (S == sph::hash_site::append)
+    auto copy_hash(R const& input, std::span<uint8_t> output, size_t target_hash_size = 0) -> size_t
+    {
+        return sph::ranges::views::detail::copy_hash_append<A>(sph::ranges::views::detail::range_bytes(input), output, target_hash_size);
+    }
+
+    template<sph::hash_algorithm A, sph::hash_site S, sph::ranges::views::detail::copy_hash_range R>
+        requires (S == sph::hash_site::append && sph::ranges::views::detail::has_algorithm_parameters<A>)
+    auto copy_hash(R const& input, std::span<uint8_t> output, size_t target_hash_size, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> size_t
+    {
+        return sph::ranges::views::detail::copy_hash_append<A>(sph::ranges::views::detail::range_bytes(input), output, target_hash_size, parameters);
+    }
+}
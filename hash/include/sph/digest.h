@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+
+namespace sph
+{
+    /**
+     * A digest held by value: N bytes of algorithm A's hash.
+     *
+     * It is trivially copyable and exactly N bytes, so a vector of digests
+     * is a digest matrix and a map keyed on digests holds them in place
+     * instead of through a heap-allocated vector each. Equality compares
+     * 8 bytes at a time, and ordering is the lexicographic byte order.
+     *
+     * @tparam A The hash algorithm the digest is from.
+     * @tparam N The digest size in bytes; by default the algorithm's.
+     */
+    template<sph::hash_algorithm A, size_t N = sph::hash_param<A>::hash_byte_count()>
+        requires (N > 0)
+    class digest
+    {
+        std::array<uint8_t, N> bytes_{};
+    public:
+        static constexpr sph::hash_algorithm algorithm{ A };
+
+        constexpr digest() = default;
+
+        /**
+         * @param bytes the digest bytes.
+         */
+        constexpr explicit digest(std::span<uint8_t const, N> bytes)
+        {
+            std::ranges::copy(bytes, bytes_.begin());
+        }
+
+        static constexpr auto size() -> size_t { return N; }
+        constexpr auto data() -> uint8_t* { return bytes_.data(); }
+        constexpr auto data() const -> uint8_t const* { return bytes_.data(); }
+        constexpr auto begin() -> uint8_t* { return bytes_.data(); }
+        constexpr auto begin() const -> uint8_t const* { return bytes_.data(); }
+        constexpr auto end() -> uint8_t* { return bytes_.data() + N; }
+        constexpr auto end() const -> uint8_t const* { return bytes_.data() + N; }
+        constexpr auto operator[](size_t index) -> uint8_t& { return bytes_[index]; }
+        constexpr auto operator[](size_t index) const -> uint8_t { return bytes_[index]; }
+
+        constexpr auto bytes() -> std::span<uint8_t, N>
+        {
+            return bytes_;
+        }
+
+        constexpr auto bytes() const -> std::span<uint8_t const, N>
+        {
+            return bytes_;
+        }
+
+        /**
+         * The first eight bytes (fewer if the digest is shorter, zero-filled)
+         * as an integer in native byte order. A digest's bytes are uniformly
+         * distributed, so this is a ready-made hash-table hash or shard key.
+         */
+        auto prefix() const -> uint64_t
+        {
+            uint64_t ret{};
+            std::memcpy(&ret, bytes_.data(), std::min(N, sizeof(ret)));
+            return ret;
+        }
+
+        friend auto operator==(digest const& lhs, digest const& rhs) -> bool
+        {
+            uint64_t difference{};
+            size_t i{};
+            for (; i + sizeof(uint64_t) <= N; i += sizeof(uint64_t))
+            {
+                uint64_t l{};
+                uint64_t r{};
+                std::memcpy(&l, lhs.bytes_.data() + i, sizeof(l));
+                std::memcpy(&r, rhs.bytes_.data() + i, sizeof(r));
+                difference |= l ^ r;
+            }
+
+            for (; i < N; ++i)
+            {
+                difference |= static_cast<uint64_t>(lhs.bytes_[i] ^ rhs.bytes_[i]);
+            }
+
+            return difference == 0;
+        }
+
+        friend auto operator<=>(digest const& lhs, digest const& rhs) -> std::strong_ordering
+        {
+            return std::memcmp(lhs.bytes_.data(), rhs.bytes_.data(), N) <=> 0;
+        }
+    };
+}
+
+template<sph::hash_algorithm A, size_t N>
+struct std::hash<sph::digest<A, N>>
+{
+    auto operator()(sph::digest<A, N> const& value) const noexcept -> size_t
+    {
+        return std::hash<uint64_t>{}(value.prefix());
+    }
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include <string_view>
+
+namespace sph
+{
+    /**
+     * @brief Parameters for hash_algorithm::git_sha1 and
+     * hash_algorithm::git_sha256.
+     *
+     * The input is hashed as the content of a git object of this type:
+     * "blob", "tree", "commit", or "tag". The object's size in the header git
+     * puts before the content comes from the input range itself.
+     */
+    struct git_object_parameters
+    {
+        std::string_view type{ "blob" };
+    };
+}
@@ -8,6 +8,9 @@ namespace sph
     // hash_site are all unique.
     /**
      * @brief Enum representing the hash algorithm.
+     *
+     * Values 10 through 29 belong to hash_format and hash_site, so newer
+     * algorithms continue from 30.
      */
     enum class hash_algorithm : uint8_t
     {
@@ -17,5 +20,23 @@ namespace sph
         sha3_256 = 3,
         sha3_512 = 4,
         blake3 = 5,
+        siphash24 = 6,
+        siphashx24 = 7,
+        poly1305 = 8,
+        blake2s = 9,
+        blake2bp = 30,
+        blake2sp = 31,
+        k12 = 32,
+        turboshake128 = 33,
+        turboshake256 = 34,
+        shake128 = 35,
+        shake256 = 36,
+        parallelhash128 = 37,
+        parallelhash256 = 38,
+        sha512_256 = 39,
+        sha512_224 = 40,
+        sha1 = 41,
+        git_sha1 = 42,
+        git_sha256 = 43,
     };
 }
@@ -0,0 +1,406 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <format>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <sph/digest.h>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/batch_hasher.h>
+#include <sph/ranges/views/detail/hash_util.h>
+#include <sph/ranges/views/detail/thread_pool.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * Hash each message into the next row of digests.
+     */
+    template<sph::hash_algorithm A, message_range M>
+    auto hash_each_into(M&& messages, std::span<uint8_t> digests, batch_hasher<A> const& hasher) -> size_t
+    {
+        auto const digest_size{ hasher.digest_size() };
+        if constexpr (std::ranges::sized_range<M>)
+        {
+            // check up front so nothing is written when it can't all fit
+            if (auto const count{ static_cast<size_t>(std::ranges::size(messages)) }; digests.size() < count * digest_size)
+            {
+                throw std::invalid_argument(std::format("Digest buffer of {} bytes is too small for {} digests of {} bytes.", digests.size(), count, digest_size));
+            }
+        }
+
+        size_t count{};
+        for (auto&& message : messages)
+        {
+            if (digests.size() < (count + 1) * digest_size)
+            {
+                throw std::invalid_argument(std::format("Digest buffer of {} bytes is too small for more than {} digests of {} bytes.", digests.size(), count, digest_size));
+            }
+
+            hasher.hash(std::forward<decltype(message)>(message), digests.subspan(count * digest_size, digest_size));
+            ++count;
+        }
+
+        return count;
+    }
+
+    /**
+     * Hash each message into a new row of a digest vector.
+     */
+    template<sph::hash_algorithm A, message_range M>
+    auto hash_each_to_vector(M&& messages, batch_hasher<A> const& hasher) -> std::vector<uint8_t>
+    {
+        auto const digest_size{ hasher.digest_size() };
+        std::vector<uint8_t> digests;
+        if constexpr (std::ranges::sized_range<M>)
+        {
+            digests.resize(static_cast<size_t>(std::ranges::size(messages)) * digest_size);
+            hash_each_into<A>(std::forward<M>(messages), digests, hasher);
+        }
+        else
+        {
+            for (auto&& message : messages)
+            {
+                digests.resize(digests.size() + digest_size);
+                hasher.hash(std::forward<decltype(message)>(message), std::span<uint8_t>{ digests }.last(digest_size));
+            }
+        }
+
+        return digests;
+    }
+
+    /**
+     * The bytes of an array of digests, which are laid out as a digest
+     * matrix.
+     */
+    template<sph::hash_algorithm A, size_t N>
+    auto digest_bytes(std::span<sph::digest<A, N>> digests) -> std::span<uint8_t>
+    {
+        static_assert(sizeof(sph::digest<A, N>) == N && std::is_trivially_copyable_v<sph::digest<A, N>>);
+        return { reinterpret_cast<uint8_t*>(digests.data()), digests.size_bytes() };
+    }
+
+    /**
+     * Hash each message into a new digest value.
+     */
+    template<sph::hash_algorithm A, size_t N, message_range M>
+    auto hash_each_to_digests(M&& messages, batch_hasher<A> const& hasher) -> std::vector<sph::digest<A, N>>
+    {
+        std::vector<sph::digest<A, N>> digests;
+        if constexpr (std::ranges::sized_range<M>)
+        {
+            digests.resize(static_cast<size_t>(std::ranges::size(messages)));
+            hash_each_into<A>(std::forward<M>(messages), digest_bytes(std::span{ digests }), hasher);
+        }
+        else
+        {
+            for (auto&& message : messages)
+            {
+                hasher.hash(std::forward<decltype(message)>(message), digests.emplace_back().bytes());
+            }
+        }
+
+        return digests;
+    }
+
+    /**
+     * A range of messages that can be split between threads by index.
+     */
+    template <typename M>
+    concept parallel_message_range = message_range<M>
+        && std::ranges::random_access_range<M>
+        && std::ranges::sized_range<M>;
+
+    /**
+     * Hash each message into its row of digests, spread over a thread pool;
+     * by default the one shared by all hashes.
+     *
+     * The pool hands out tasks of a few messages each from a shared counter,
+     * so a thread that finishes early takes the next task rather than
+     * idling while another works through large messages. Each message is
+     * hashed on the stack of the thread that takes it, from a copy of the
+     * batch's initial state. Tasks are split where a digest starts on a
+     * 64-byte aligned address, so threads don't write to the same cache
+     * line. Digests of a size that never lines up with the buffer (say 32
+     * bytes from an odd address) can't be split that way; then neighbouring
+     * tasks share the line their boundary falls in.
+     */
+    template<sph::hash_algorithm A, parallel_message_range M>
+    auto hash_each_parallel_into(M&& messages, std::span<uint8_t> digests, batch_hasher<A> const& hasher, thread_pool& pool = thread_pool::shared()) -> size_t
+    {
+        static constexpr size_t cache_line_size{ 64 };
+        static constexpr size_t tasks_per_thread{ 8 };
+        auto const digest_size{ hasher.digest_size() };
+        auto const count{ static_cast<size_t>(std::ranges::size(messages)) };
+        if (digests.size() < count * digest_size)
+        {
+            throw std::invalid_argument(std::format("Digest buffer of {} bytes is too small for {} digests of {} bytes.", digests.size(), count, digest_size));
+        }
+
+        // every line_messages-th digest starts on a cache line; find the
+        // first one that does, if any
+        auto const line_messages{ cache_line_size / std::gcd(digest_size, cache_line_size) };
+        auto const address{ reinterpret_cast<uintptr_t>(digests.data()) };
+        size_t aligned_message{};
+        while (aligned_message < line_messages && (address + (aligned_message * digest_size)) % cache_line_size != 0)
+        {
+            ++aligned_message;
+        }
+
+        if (aligned_message == line_messages)
+        {
+            aligned_message = 0;
+        }
+
+        // the first task also takes the messages before the first aligned one
+        auto const target_messages{ std::max<size_t>(count / (pool.size() * tasks_per_thread), 1) };
+        auto const messages_per_task{ ((target_messages + line_messages - 1) / line_messages) * line_messages };
+        auto const task_count{ count > aligned_message ? (count - aligned_message + messages_per_task - 1) / messages_per_task : 1 };
+        auto const task_first{ [&](size_t task) -> size_t { return task == 0 ? 0 : std::min(aligned_message + (task * messages_per_task), count); } };
+        auto const first_message{ std::ranges::begin(messages) };
+        auto const hash_task{ [&](size_t task) -> void
+            {
+                auto const first{ task_first(task) };
+                auto const last{ task_first(task + 1) };
+                for (auto i = first; i < last; ++i)
+                {
+                    hasher.hash(first_message[static_cast<std::ranges::range_difference_t<M>>(i)], digests.subspan(i * digest_size, digest_size));
+                }
+            } };
+        if (task_count <= 1 || pool.size() == 1)
+        {
+            for (size_t task = 0; task < task_count; ++task)
+            {
+                hash_task(task);
+            }
+        }
+        else
+        {
+            pool.run(task_count, hash_task);
+        }
+
+        return count;
+    }
+
+    /**
+     * A value that a digest's bytes can be copied straight into: an unsigned
+     * integer, or an array of them for a 128-bit value.
+     */
+    template <typename T>
+    concept hash_scalar = std::is_trivially_copyable_v<T>
+        && std::is_trivially_default_constructible_v<T>
+        && std::has_unique_object_representations_v<T>;
+
+    /**
+     * Hash one message into a sizeof(T)-byte digest held as a T.
+     */
+    template<typename T, sph::hash_algorithm A, hash_range M>
+    auto hash_to_scalar(M&& message, batch_hasher<A> const& hasher) -> T
+    {
+        static_assert(sizeof(T) <= sph::hash_param<A>::hash_byte_count() || sph::hash_param<A>::extendable_output(),
+            "The scalar is larger than the algorithm's hash size.");
+        std::array<uint8_t, sizeof(T)> bytes{};
+        hasher.hash(std::forward<M>(message), bytes);
+        T ret;
+        std::memcpy(&ret, bytes.data(), sizeof(T));
+        return ret;
+    }
+}
+
+namespace sph
+{
+    /**
+     * Hash each message of a range into consecutive rows of a digest
+     * matrix: the digest of message i is at
+     * <code>digests[i * size, (i + 1) * size)</code>, where size is the
+     * target hash size.
+     *
+     * Digests are raw and separate, the same bytes as
+     * <code>message | sph::views::hash<A>(target_hash_size)</code>, but the
+     * hash state is set up once for the whole batch instead of a view,
+     * iterator, and heap-allocated hash state per message.
+     *
+     * @tparam A The hash algorithm to use.
+     * @param messages The messages to hash.
+     * @param digests Where to write the digests. Throws
+     *      <code>std::invalid_argument</code> if it is too small; when the
+     *      number of messages is known up front, before hashing any.
+     * @param target_hash_size The size in bytes of each digest; zero for
+     *      <code>sph::hash_param<A>::hash_byte_count()</code>.
+     * @return the number of digests written.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::message_range M>
+    auto hash_each(M&& messages, std::span<uint8_t> digests, size_t target_hash_size = 0) -> size_t
+    {
+        return sph::ranges::views::detail::hash_each_into<A>(std::forward<M>(messages), digests, sph::ranges::views::detail::batch_hasher<A>{ target_hash_size });
+    }
+
+    /**
+     * Hash each message with the given algorithm parameters (key, salt,
+     * etc.), which are validated once for the whole batch.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::message_range M>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto hash_each(M&& messages, std::span<uint8_t> digests, size_t target_hash_size, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> size_t
+    {
+        return sph::ranges::views::detail::hash_each_into<A>(std::forward<M>(messages), digests, sph::ranges::views::detail::batch_hasher<A>{ target_hash_size, parameters });
+    }
+
+    /**
+     * Hash each message into a newly allocated digest matrix.
+     *
+     * @return the digests, one row of the target hash size per message.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::message_range M>
+    auto hash_each(M&& messages, size_t target_hash_size = 0) -> std::vector<uint8_t>
+    {
+        return sph::ranges::views::detail::hash_each_to_vector<A>(std::forward<M>(messages), sph::ranges::views::detail::batch_hasher<A>{ target_hash_size });
+    }
+
+    template<sph::hash_algorithm A, sph::ranges::views::detail::message_range M>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto hash_each(M&& messages, size_t target_hash_size, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> std::vector<uint8_t>
+    {
+        return sph::ranges::views::detail::hash_each_to_vector<A>(std::forward<M>(messages), sph::ranges::views::detail::batch_hasher<A>{ target_hash_size, parameters });
+    }
+
+    /**
+     * Hash one message into a digest value, without a view, iterator, or
+     * heap allocation.
+     *
+     * @tparam A The hash algorithm to use.
+     * @tparam N The digest size in bytes; by default the algorithm's.
+     * @param message The message to hash.
+     * @return the digest.
+     */
+    template<sph::hash_algorithm A, size_t N = sph::hash_param<A>::hash_byte_count(), sph::ranges::views::detail::hash_range M>
+    auto hash_digest(M&& message) -> sph::digest<A, N>
+    {
+        sph::digest<A, N> ret;
+        sph::ranges::views::detail::batch_hasher<A>{ N }.hash(std::forward<M>(message), ret.bytes());
+        return ret;
+    }
+
+    template<sph::hash_algorithm A, size_t N = sph::hash_param<A>::hash_byte_count(), sph::ranges::views::detail::hash_range M>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto hash_digest(M&& message, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> sph::digest<A, N>
+    {
+        sph::digest<A, N> ret;
+        sph::ranges::views::detail::batch_hasher<A>{ N, parameters }.hash(std::forward<M>(message), ret.bytes());
+        return ret;
+    }
+
+    /**
+     * Hash one message straight into an integer, e.g.
+     * <code>sph::hash_to<uint64_t, sph::hash_algorithm::blake2b>(key)</code>
+     * for a hash-table hash or shard key.
+     *
+     * The value is the sizeof(T)-byte digest,
+     * <code>sph::hash_digest<A, sizeof(T)>(message)</code>, in native byte
+     * order. There is no view, iterator, padding, or heap allocation, and a
+     * key shorter than one block is hashed with a single call.
+     *
+     * @tparam T The value type; e.g. uint64_t, or
+     *      <code>std::array<uint64_t, 2></code> for 128 bits.
+     * @tparam A The hash algorithm to use.
+     * @param message The message to hash.
+     * @return the hash as a T.
+     */
+    template<sph::ranges::views::detail::hash_scalar T, sph::hash_algorithm A = sph::hash_algorithm::blake2b, sph::ranges::views::detail::hash_range M>
+    auto hash_to(M&& message) -> T
+    {
+        return sph::ranges::views::detail::hash_to_scalar<T, A>(std::forward<M>(message), sph::ranges::views::detail::batch_hasher<A>{ sizeof(T) });
+    }
+
+    template<sph::ranges::views::detail::hash_scalar T, sph::hash_algorithm A, sph::ranges::views::detail::hash_range M>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto hash_to(M&& message, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> T
+    {
+        return sph::ranges::views::detail::hash_to_scalar<T, A>(std::forward<M>(message), sph::ranges::views::detail::batch_hasher<A>{ sizeof(T), parameters });
+    }
+
+    /**
+     * Hash each message into a vector of N-byte digest values, e.g.
+     * <code>sph::hash_each<sph::hash_algorithm::sha256, 32>(messages)</code>.
+     * The vector's storage is the digest matrix the other overloads write.
+     *
+     * @return the digests, one per message.
+     */
+    template<sph::hash_algorithm A, size_t N, sph::ranges::views::detail::message_range M>
+    auto hash_each(M&& messages) -> std::vector<sph::digest<A, N>>
+    {
+        return sph::ranges::views::detail::hash_each_to_digests<A, N>(std::forward<M>(messages), sph::ranges::views::detail::batch_hasher<A>{ N });
+    }
+
+    template<sph::hash_algorithm A, size_t N, sph::ranges::views::detail::message_range M>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto hash_each(M&& messages, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> std::vector<sph::digest<A, N>>
+    {
+        return sph::ranges::views::detail::hash_each_to_digests<A, N>(std::forward<M>(messages), sph::ranges::views::detail::batch_hasher<A>{ N, parameters });
+    }
+
+    /**
+     * Hash each message into consecutive rows of a digest matrix, as
+     * hash_each() does, spreading the messages over one thread per core.
+     *
+     * Digests are written in message order whichever thread hashes them.
+     * The messages are read concurrently, so they must be safe to read from
+     * several threads at once.
+     *
+     * @tparam A The hash algorithm to use.
+     * @param messages The messages to hash; a sized, random-access range.
+     * @param digests Where to write the digests. Throws
+     *      <code>std::invalid_argument</code> before hashing any if it is
+     *      too small.
+     * @param target_hash_size The size in bytes of each digest; zero for
+     *      <code>sph::hash_param<A>::hash_byte_count()</code>.
+     * @return the number of digests written.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::parallel_message_range M>
+    auto hash_each_parallel(M&& messages, std::span<uint8_t> digests, size_t target_hash_size = 0) -> size_t
+    {
+        return sph::ranges::views::detail::hash_each_parallel_into<A>(std::forward<M>(messages), digests, sph::ranges::views::detail::batch_hasher<A>{ target_hash_size });
+    }
+
+    template<sph::hash_algorithm A, sph::ranges::views::detail::parallel_message_range M>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto hash_each_parallel(M&& messages, std::span<uint8_t> digests, size_t target_hash_size, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> size_t
+    {
+        return sph::ranges::views::detail::hash_each_parallel_into<A>(std::forward<M>(messages), digests, sph::ranges::views::detail::batch_hasher<A>{ target_hash_size, parameters });
+    }
+
+    /**
+     * Hash each message, spread over one thread per core, into a newly
+     * allocated digest matrix.
+     *
+     * @return the digests, one row of the target hash size per message.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::parallel_message_range M>
+    auto hash_each_parallel(M&& messages, size_t target_hash_size = 0) -> std::vector<uint8_t>
+    {
+        sph::ranges::views::detail::batch_hasher<A> const hasher{ target_hash_size };
+        std::vector<uint8_t> digests(static_cast<size_t>(std::ranges::size(messages)) * hasher.digest_size());
+        sph::ranges::views::detail::hash_each_parallel_into<A>(std::forward<M>(messages), digests, hasher);
+        return digests;
+    }
+
+    template<sph::hash_algorithm A, sph::ranges::views::detail::parallel_message_range M>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto hash_each_parallel(M&& messages, size_t target_hash_size, sph::ranges::views::detail::algorithm_parameters_t<A> parameters) -> std::vector<uint8_t>
+    {
+        sph::ranges::views::detail::batch_hasher<A> const hasher{ target_hash_size, parameters };
+        std::vector<uint8_t> digests(static_cast<size_t>(std::ranges::size(messages)) * hasher.digest_size());
+        sph::ranges::views::detail::hash_each_parallel_into<A>(std::forward<M>(messages), digests, hasher);
+        return digests;
+    }
+}
@@ -13,5 +13,9 @@ namespace sph
     {
         raw = 10,
         padded = 11,
+        // text: lower-case hex, upper-case hex, and unpadded base64url
+        hex = 12,
+        hex_upper = 13,
+        base64url = 14,
     };
 }
@@ -0,0 +1,133 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <sph/hash_algorithm.h>
+#include <sph/hasher.h>
+#include <sph/ranges/views/detail/hash_util.h>
+
+namespace sph
+{
+    /**
+     * An output iterator that hashes everything written through it on its
+     * way to another output iterator.
+     *
+     * The hash state is a caller-owned sph::hasher, so the copies that
+     * algorithms make of the iterator all feed the same hash, and the digest
+     * is read from the hasher afterwards. Each value assigned is hashed as
+     * its bytes, the way the hash view hashes a range of them.
+     *
+     * Assigning a value at a time stages it in the hasher's chunk buffer.
+     * sph::ranges::copy instead hashes a contiguous source in one update()
+     * and copies it with std::ranges::copy into the underlying iterator.
+     *
+     * @tparam A The hash algorithm.
+     * @tparam O The underlying output iterator.
+     */
+    template<sph::hash_algorithm A, std::input_or_output_iterator O>
+    class hash_output_iterator
+    {
+        O out_;
+        sph::hasher<A>* hasher_;
+    public:
+        using iterator_category = std::output_iterator_tag;
+        using value_type = void;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = void;
+
+        /**
+         * @param out Where to write.
+         * @param hasher The hash to feed; it must outlive the iterator.
+         */
+        hash_output_iterator(O out, sph::hasher<A>& hasher)
+            : out_{ std::move(out) }
+            , hasher_{ &hasher }
+        {
+        }
+
+        /**
+         * Hash the value and write it to the underlying iterator.
+         */
+        template<typename T>
+            requires (!std::is_same_v<std::remove_cvref_t<T>, hash_output_iterator>
+                && sph::ranges::views::detail::hashable_type<std::remove_cvref_t<T>>
+                && std::indirectly_writable<O, T>)
+        auto operator=(T&& value) -> hash_output_iterator&
+        {
+            std::remove_cvref_t<T> const hashed{ value };
+            hasher_->update(std::span<std::remove_cvref_t<T> const, 1>{ &hashed, 1 });
+            *out_ = std::forward<T>(value);
+            ++out_;
+            return *this;
+        }
+
+        auto operator*() -> hash_output_iterator& { return *this; }
+        auto operator++() -> hash_output_iterator& { return *this; }
+
+        /**
+         * Returns this iterator, not a copy, so `*it++ = v` writes through
+         * it and advances the underlying iterator.
+         */
+        auto operator++(int) -> hash_output_iterator& { return *this; }
+
+        /**
+         * Gets the underlying iterator, just past the last value written.
+         */
+        auto base() const& -> O const& { return out_; }
+        auto base() && -> O { return std::move(out_); }
+
+        auto hasher() const -> sph::hasher<A>& { return *hasher_; }
+    };
+}
+
+namespace sph::ranges
+{
+    /**
+     * std::ranges::copy, with a block path for a hash_output_iterator: a
+     * contiguous source is hashed with one update() and copied with
+     * std::ranges::copy into the underlying iterator, which in turn takes
+     * its own memmove path when it can. Other sources and iterators are
+     * copied with std::ranges::copy.
+     */
+    template<std::input_iterator I, std::sentinel_for<I> S, std::weakly_incrementable O>
+        requires std::indirectly_copyable<I, O>
+    auto copy(I first, S last, O out) -> std::ranges::copy_result<I, O>
+    {
+        return std::ranges::copy(std::move(first), std::move(last), std::move(out));
+    }
+
+    template<std::contiguous_iterator I, std::sized_sentinel_for<I> S, sph::hash_algorithm A, std::input_or_output_iterator O>
+        requires (std::indirectly_copyable<I, O> && sph::ranges::views::detail::hashable_type<std::iter_value_t<I>>)
+    auto copy(I first, S last, sph::hash_output_iterator<A, O> out) -> std::ranges::copy_result<I, sph::hash_output_iterator<A, O>>
+    {
+        auto& hasher{ out.hasher() };
+        if (auto const count{ static_cast<size_t>(last - first) }; count != 0)
+        {
+            hasher.update(std::span<std::iter_value_t<I> const>{ std::to_address(first), count });
+        }
+
+        auto [in, written] { std::ranges::copy(std::move(first), std::move(last), std::move(out).base()) };
+        return { std::move(in), sph::hash_output_iterator<A, O>{ std::move(written), hasher } };
+    }
+
+    template<std::ranges::input_range R, std::weakly_incrementable O>
+        requires std::indirectly_copyable<std::ranges::iterator_t<R>, O>
+    auto copy(R&& input, O out) -> std::ranges::copy_result<std::ranges::borrowed_iterator_t<R>, O>
+    {
+        if constexpr (std::ranges::borrowed_range<R>)
+        {
+            return sph::ranges::copy(std::ranges::begin(input), std::ranges::end(input), std::move(out));
+        }
+        else
+        {
+            auto [in, written] { sph::ranges::copy(std::ranges::begin(input), std::ranges::end(input), std::move(out)) };
+            (void)in;
+            return { std::ranges::dangling{}, std::move(written) };
+        }
+    }
+}
@@ -34,6 +34,69 @@ namespace sph
             {
                 return 32;
             }
+            else if constexpr (A == hash_algorithm::siphash24)
+            {
+                return 8;
+            }
+            else if constexpr (A == hash_algorithm::siphashx24)
+            {
+                return 16;
+            }
+            else if constexpr (A == hash_algorithm::poly1305)
+            {
+                return 16;
+            }
+            else if constexpr (A == hash_algorithm::blake2s)
+            {
+                return 32;
+            }
+            else if constexpr (A == hash_algorithm::blake2bp)
+            {
+                return 64;
+            }
+            else if constexpr (A == hash_algorithm::blake2sp)
+            {
+                return 32;
+            }
+            else if constexpr (A == hash_algorithm::k12 || A == hash_algorithm::turboshake128 || A == hash_algorithm::turboshake256)
+            {
+                // extendable output; any shorter size is a prefix of this
+                return 64;
+            }
+            else if constexpr (A == hash_algorithm::shake128)
+            {
+                // the default; extendable output
+                return 32;
+            }
+            else if constexpr (A == hash_algorithm::shake256)
+            {
+                // the default; extendable output
+                return 64;
+            }
+            else if constexpr (A == hash_algorithm::parallelhash128)
+            {
+                return 32;
+            }
+            else if constexpr (A == hash_algorithm::parallelhash256)
+            {
+                return 64;
+            }
+            else if constexpr (A == hash_algorithm::sha512_256)
+            {
+                return 32;
+            }
+            else if constexpr (A == hash_algorithm::sha512_224)
+            {
+                return 28;
+            }
+            else if constexpr (A == hash_algorithm::sha1 || A == hash_algorithm::git_sha1)
+            {
+                return 20;
+            }
+            else if constexpr (A == hash_algorithm::git_sha256)
+            {
+                return 32;
+            }
             else
             {
                 throw std::invalid_argument("Unsupported hash algorithm");
@@ -42,11 +105,11 @@ namespace sph
 
         static constexpr auto chunk_size() -> size_t
         {
-            if constexpr (A == hash_algorithm::sha256)
+            if constexpr (A == hash_algorithm::sha256 || A == hash_algorithm::sha1 || A == hash_algorithm::git_sha1 || A == hash_algorithm::git_sha256)
             {
                 return 64;
             }
-            else if constexpr (A == hash_algorithm::sha512)
+            else if constexpr (A == hash_algorithm::sha512 || A == hash_algorithm::sha512_256 || A == hash_algorithm::sha512_224)
             {
                 return 128;
             }
@@ -66,12 +129,57 @@ namespace sph
             {
                 return 1024;
             }
+            else if constexpr (A == hash_algorithm::siphash24 || A == hash_algorithm::siphashx24)
+            {
+                return 64;
+            }
+            else if constexpr (A == hash_algorithm::poly1305)
+            {
+                return 64;
+            }
+            else if constexpr (A == hash_algorithm::blake2s)
+            {
+                return 64;
+            }
+            else if constexpr (A == hash_algorithm::blake2bp || A == hash_algorithm::blake2sp)
+            {
+                // one block for each leaf
+                return 512;
+            }
+            else if constexpr (A == hash_algorithm::k12 || A == hash_algorithm::turboshake128 || A == hash_algorithm::shake128 || A == hash_algorithm::parallelhash128)
+            {
+                return 168;
+            }
+            else if constexpr (A == hash_algorithm::turboshake256 || A == hash_algorithm::shake256 || A == hash_algorithm::parallelhash256)
+            {
+                return 136;
+            }
             else
             {
                 throw std::invalid_argument("Unsupported hash algorithm");
             }
         }
 
+        /**
+         * The block size for copying and hashing in one pass: a whole number
+         * of chunks, small enough that a block's source and destination stay
+         * in a 32 KiB L1 data cache between the copy and the hash. The tree
+         * hashes take larger blocks so each update has several leaves' worth
+         * of chunks to work through.
+         */
+        static constexpr auto copy_block_size() -> size_t
+        {
+            if constexpr (A == hash_algorithm::blake2bp || A == hash_algorithm::blake2sp || A == hash_algorithm::blake3
+                || A == hash_algorithm::k12 || A == hash_algorithm::parallelhash128 || A == hash_algorithm::parallelhash256)
+            {
+                return (16384 / chunk_size()) * chunk_size();
+            }
+            else
+            {
+                return (8192 / chunk_size()) * chunk_size();
+            }
+        }
+
         static constexpr auto name() -> std::string_view
         {
             if constexpr (A == hash_algorithm::sha256)
@@ -98,10 +206,103 @@ namespace sph
             {
                 return "BLAKE3";
             }
+            else if constexpr (A == hash_algorithm::siphash24)
+            {
+                return "SIPHASH-2-4";
+            }
+            else if constexpr (A == hash_algorithm::siphashx24)
+            {
+                return "SIPHASHX-2-4";
+            }
+            else if constexpr (A == hash_algorithm::poly1305)
+            {
+                return "POLY1305";
+            }
+            else if constexpr (A == hash_algorithm::blake2s)
+            {
+                return "BLAKE2S";
+            }
+            else if constexpr (A == hash_algorithm::blake2bp)
+            {
+                return "BLAKE2BP";
+            }
+            else if constexpr (A == hash_algorithm::blake2sp)
+            {
+                return "BLAKE2SP";
+            }
+            else if constexpr (A == hash_algorithm::k12)
+            {
+                return "K12";
+            }
+            else if constexpr (A == hash_algorithm::turboshake128)
+            {
+                return "TURBOSHAKE128";
+            }
+            else if constexpr (A == hash_algorithm::turboshake256)
+            {
+                return "TURBOSHAKE256";
+            }
+            else if constexpr (A == hash_algorithm::shake128)
+            {
+                return "SHAKE128";
+            }
+            else if constexpr (A == hash_algorithm::shake256)
+            {
+                return "SHAKE256";
+            }
+            else if constexpr (A == hash_algorithm::parallelhash128)
+            {
+                return "PARALLELHASH128";
+            }
+            else if constexpr (A == hash_algorithm::parallelhash256)
+            {
+                return "PARALLELHASH256";
+            }
+            else if constexpr (A == hash_algorithm::sha512_256)
+            {
+                return "SHA512/256";
+            }
+            else if constexpr (A == hash_algorithm::sha512_224)
+            {
+                return "SHA512/224";
+            }
+            else if constexpr (A == hash_algorithm::sha1)
+            {
+                return "SHA1";
+            }
+            else if constexpr (A == hash_algorithm::git_sha1)
+            {
+                return "GIT-SHA1";
+            }
+            else if constexpr (A == hash_algorithm::git_sha256)
+            {
+                return "GIT-SHA256";
+            }
             else
             {
                 throw std::invalid_argument("Unsupported hash algorithm");
             }
         }
+
+        /**
+         * Whether the algorithm is an extendable-output function. Their raw,
+         * separate hashes may be any length; hash_byte_count() is only the
+         * default and the cap when the hash is padded or appended.
+         */
+        static constexpr auto extendable_output() -> bool
+        {
+            return A == hash_algorithm::shake128 || A == hash_algorithm::shake256
+                || A == hash_algorithm::k12 || A == hash_algorithm::turboshake128 || A == hash_algorithm::turboshake256;
+        }
+
+        /**
+         * Whether the algorithm hashes its input as a git object, behind a
+         * header that holds the input's length, so the length must be known
+         * before hashing starts.
+         */
+        static constexpr auto git_object() -> bool
+        {
+            return A == hash_algorithm::git_sha1 || A == hash_algorithm::git_sha256;
+        }
     };
 }
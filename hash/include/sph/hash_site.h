@@ -14,5 +14,9 @@ namespace sph
     {
         append = 21,
         separate = 22,
+        // the hash comes first, then the input; hashing reads the input twice
+        prepend = 23,
+        // a hash follows every block of the input; see interleave_parameters
+        interleave = 24,
     };
 }
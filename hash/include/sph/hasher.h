@@ -0,0 +1,201 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <sph/digest.h>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_format.h>
+#include <sph/hash_param.h>
+#include <sph/hash_site.h>
+#include <sph/ranges/views/detail/algorithm_hash.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/batch_hasher.h>
+#include <sph/ranges/views/detail/get_hash_size.h>
+#include <sph/ranges/views/detail/hash_util.h>
+
+namespace sph
+{
+    /**
+     * A push-style hash: feed it bytes as they arrive with update(), then
+     * read the digest with finalize_into().
+     *
+     * update() takes any number of bytes. Whole chunks go straight from
+     * the caller's buffer to the hash; only a partial chunk is staged, in a
+     * buffer inside the hasher. The digest is the same bytes as
+     * <code>message | sph::views::hash<A>(target_hash_size)</code> over all
+     * the bytes passed to update().
+     *
+     * @tparam A The hash algorithm to use.
+     */
+    template<sph::hash_algorithm A>
+    class hasher
+    {
+        using hash_t = sph::ranges::views::detail::algorithm_hash_t<A>;
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+        static constexpr size_t chunk_size{ hash_t::chunk_size };
+        size_t digest_size_;
+        hash_t hash_;
+        std::array<uint8_t, chunk_size> chunk_{};
+        size_t filled_{};
+        uint64_t byte_count_{};
+        uint64_t object_size_{};
+        bool finalized_{ false };
+    public:
+        /**
+         * @param target_hash_size The digest size; zero for the algorithm's
+         * default. Throws std::invalid_argument if it is too large.
+         */
+        explicit hasher(size_t target_hash_size = 0)
+            requires (!sph::hash_param<A>::git_object())
+            : digest_size_{ get_digest_size(target_hash_size) }
+            , hash_{ digest_size_ }
+        {
+        }
+
+        /**
+         * @param target_hash_size The digest size; zero for the algorithm's
+         * default.
+         * @param parameters The algorithm parameters (key, salt, etc.).
+         */
+        hasher(size_t target_hash_size, algorithm_parameters_t parameters)
+            requires (sph::ranges::views::detail::has_algorithm_parameters<A> && !sph::hash_param<A>::git_object())
+            : digest_size_{ get_digest_size(target_hash_size) }
+            , hash_{ digest_size_, parameters }
+        {
+        }
+
+        /**
+         * A git object's header holds its size, so it is needed up front;
+         * finalize_into() throws std::runtime_error if a different number
+         * of bytes was hashed.
+         * @param object_size The number of bytes update() will be given.
+         * @param target_hash_size The digest size; zero for the algorithm's
+         * default.
+         * @param parameters The git object type.
+         */
+        explicit hasher(uint64_t object_size, size_t target_hash_size = 0, algorithm_parameters_t parameters = {})
+            requires (sph::hash_param<A>::git_object())
+            : digest_size_{ get_digest_size(target_hash_size) }
+            , hash_{ digest_size_, parameters, object_size }
+            , object_size_{ object_size }
+        {
+        }
+
+        auto digest_size() const -> size_t
+        {
+            return digest_size_;
+        }
+
+        /**
+         * Hash more of the message.
+         * @param input The next bytes, or the next elements of any contiguous
+         * range, which are hashed as their bytes.
+         */
+        template<std::ranges::contiguous_range R>
+            requires (std::ranges::sized_range<R> && sph::ranges::views::detail::hashable_type<std::remove_cvref_t<std::ranges::range_value_t<R>>>)
+        auto update(R const& input) -> void
+        {
+            if (finalized_)
+            {
+                throw std::runtime_error(std::format("Cannot update a {} hasher after it is finalized.", sph::hash_param<A>::name()));
+            }
+
+            auto const count{ static_cast<size_t>(std::ranges::size(input)) * sizeof(std::ranges::range_value_t<R>) };
+            if (count == 0)
+            {
+                return;
+            }
+
+            std::span<uint8_t const> bytes{ reinterpret_cast<uint8_t const*>(std::ranges::data(input)), count };
+            byte_count_ += count;
+            if (filled_ != 0)
+            {
+                auto const take{ std::min(chunk_size - filled_, bytes.size()) };
+                std::ranges::copy_n(bytes.begin(), static_cast<ptrdiff_t>(take), chunk_.begin() + static_cast<ptrdiff_t>(filled_));
+                filled_ += take;
+                bytes = bytes.subspan(take);
+                if (filled_ < chunk_size)
+                {
+                    return;
+                }
+
+                hash_.update(std::span<uint8_t const, chunk_size>{ chunk_ });
+                filled_ = 0;
+            }
+
+            for (; bytes.size() >= chunk_size; bytes = bytes.subspan(chunk_size))
+            {
+                hash_.update(bytes.template first<chunk_size>());
+            }
+
+            std::ranges::copy(bytes, chunk_.begin());
+            filled_ = bytes.size();
+        }
+
+        /**
+         * Finish the hash and write the digest. The hasher can't be updated
+         * or finalized again.
+         * @param digest Where to write the digest; digest_size() bytes.
+         * Throws std::invalid_argument if it is a different size.
+         */
+        auto finalize_into(std::span<uint8_t> digest) -> void
+        {
+            if (digest.size() != digest_size_)
+            {
+                throw std::invalid_argument(std::format("Digest buffer of {} bytes doesn't match the {} byte {} digest.", digest.size(), digest_size_, sph::hash_param<A>::name()));
+            }
+
+            if (finalized_)
+            {
+                throw std::runtime_error(std::format("A {} hasher can only be finalized once.", sph::hash_param<A>::name()));
+            }
+
+            if constexpr (sph::hash_param<A>::git_object())
+            {
+                if (byte_count_ != object_size_)
+                {
+                    throw std::runtime_error(std::format("{} object of {} bytes was given {} bytes.", sph::hash_param<A>::name(), object_size_, byte_count_));
+                }
+            }
+
+            finalized_ = true;
+            hash_.final(std::span<uint8_t const>{ chunk_.data(), filled_ });
+            sph::ranges::views::detail::read_digest(hash_, digest);
+        }
+
+        /**
+         * Finish the hash.
+         * @return the digest, digest_size() bytes.
+         */
+        auto finalize() -> std::vector<uint8_t>
+        {
+            std::vector<uint8_t> ret(digest_size_);
+            finalize_into(ret);
+            return ret;
+        }
+
+        /**
+         * Finish the hash into a digest value.
+         * @tparam N The digest size; must be digest_size().
+         */
+        template<size_t N = sph::hash_param<A>::hash_byte_count()>
+        auto finalize_digest() -> sph::digest<A, N>
+        {
+            sph::digest<A, N> ret;
+            finalize_into(ret.bytes());
+            return ret;
+        }
+
+    private:
+        static auto get_digest_size(size_t target_hash_size) -> size_t
+        {
+            return sph::ranges::views::detail::get_hash_size<A, sph::hash_format::raw, sph::hash_site::separate>(target_hash_size);
+        }
+    };
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+
+namespace sph
+{
+    /**
+     * @brief Parameters for hash_site::interleave.
+     *
+     * The payload is cut into blocks of block_size bytes and each block is
+     * followed by its hash. The last block is always shorter than
+     * block_size, possibly empty, so a stream cut off at a block boundary
+     * doesn't verify.
+     *
+     * A chained block's hash covers the previous block's hash and then the
+     * block, so each hash vouches for everything before it and blocks can't
+     * be dropped or reordered. Unchained blocks are hashed on their own.
+     */
+    struct interleave_parameters
+    {
+        size_t block_size{ 65536 };
+        bool chained{ true };
+    };
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace sph
+{
+    /**
+     * @brief Parameters for hash_algorithm::k12.
+     *
+     * The customization string is any length, including empty. Different
+     * customization strings give unrelated hashes of the same input.
+     */
+    struct k12_parameters
+    {
+        std::span<uint8_t const> customization{};
+    };
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace sph
+{
+    /**
+     * @brief Parameters for hash_algorithm::parallelhash128 and
+     * hash_algorithm::parallelhash256.
+     *
+     * The input is cut into blocks of block_size bytes that are hashed
+     * independently. The block size is part of the hash, so it must match
+     * between hashing and verifying; it may not be zero. The customization
+     * string is any length, including empty.
+     */
+    struct parallel_hash_parameters
+    {
+        size_t block_size{ 8192 };
+        std::span<uint8_t const> customization{};
+    };
+}
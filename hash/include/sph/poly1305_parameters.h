@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace sph
+{
+    /**
+     * @brief Parameters for hash_algorithm::poly1305.
+     *
+     * Poly1305 is a one-time authenticator: the key must be exactly 32 bytes
+     * and must never be used to authenticate more than one message.
+     */
+    struct poly1305_parameters
+    {
+        std::span<uint8_t const> key{};
+    };
+}
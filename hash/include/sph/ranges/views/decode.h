@@ -0,0 +1,276 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <sph/hash_format.h>
+#include <sph/ranges/views/detail/text_encoding.h>
+
+namespace sph::ranges::views
+{
+    namespace detail
+    {
+        /**
+         * A range of single-byte characters to decode.
+         */
+        template <typename R>
+        concept encoded_range = std::ranges::forward_range<R>
+            && std::ranges::forward_range<R const>
+            && sizeof(std::ranges::range_value_t<R>) == 1
+            && std::is_trivially_copyable_v<std::ranges::range_value_t<R>>;
+
+        /**
+         * The iterator of a decode_view: decodes one hex pair or base64
+         * quantum at a time and hands out its bytes.
+         *
+         * When the text is contiguous, a hash view reading this iterator
+         * takes the undecoded text instead, through encoded() and
+         * consume(), and decodes it straight into its staging buffer.
+         *
+         * @tparam V The view of the text.
+         * @tparam F The text format: hex, hex_upper, or base64url.
+         */
+        template<encoded_range V, sph::hash_format F>
+        class decode_iterator  // NOLINT(clang-diagnostic-padded)
+        {
+            static constexpr bool base64{ F == sph::hash_format::base64url };
+            using base_iterator_t = std::ranges::iterator_t<V const>;
+            using base_sentinel_t = std::ranges::sentinel_t<V const>;
+            static constexpr bool contiguous{ std::contiguous_iterator<base_iterator_t> && std::sized_sentinel_for<base_sentinel_t, base_iterator_t> };
+            base_iterator_t quantum_begin_{};
+            base_iterator_t current_{};
+            base_sentinel_t end_{};
+            std::array<uint8_t, 3> bytes_{};
+            uint8_t size_{};
+            uint8_t position_{};
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = uint8_t;
+            static constexpr sph::hash_format encoding{ F };
+
+            decode_iterator() = default;
+
+            decode_iterator(base_iterator_t begin, base_sentinel_t end)
+                : quantum_begin_{ begin }
+                , current_{ std::move(begin) }
+                , end_{ std::move(end) }
+            {
+                decode_next();
+            }
+
+            auto operator*() const -> uint8_t
+            {
+                return bytes_[position_];
+            }
+
+            auto operator++() -> decode_iterator&
+            {
+                if (++position_ == size_)
+                {
+                    decode_next();
+                }
+
+                return *this;
+            }
+
+            auto operator++(int) -> decode_iterator
+            {
+                auto ret{ *this };
+                ++*this;
+                return ret;
+            }
+
+            auto operator==(decode_iterator const& other) const -> bool
+            {
+                return quantum_begin_ == other.quantum_begin_ && position_ == other.position_;
+            }
+
+            auto operator==(std::default_sentinel_t) const -> bool
+            {
+                return size_ == 0;
+            }
+
+            /**
+             * Gets the text not yet handed out. Only at the start of a
+             * quantum, where the iterator is when a hash first reads it.
+             */
+            auto encoded() const -> std::span<uint8_t const>
+                requires contiguous
+            {
+                auto const count{ static_cast<size_t>(end_ - quantum_begin_) };
+                if (count == 0)
+                {
+                    return {};
+                }
+
+                return { reinterpret_cast<uint8_t const*>(std::to_address(quantum_begin_)), count };
+            }
+
+            /**
+             * Move to the end of the text without decoding it; for after
+             * encoded() has been decoded elsewhere.
+             */
+            auto consume() -> void
+                requires contiguous
+            {
+                quantum_begin_ = current_ = std::ranges::next(current_, end_);
+                size_ = position_ = 0;
+            }
+
+        private:
+            auto next_char() -> uint8_t
+            {
+                auto const ret{ static_cast<uint8_t>(*current_) };
+                ++current_;
+                return ret;
+            }
+
+            auto decode_next() -> void
+            {
+                quantum_begin_ = current_;
+                size_ = position_ = 0;
+                if (current_ == end_)
+                {
+                    return;
+                }
+
+                if constexpr (base64)
+                {
+                    std::array<uint8_t, 4> text{};
+                    size_t count{};
+                    while (count < text.size() && current_ != end_ && static_cast<uint8_t>(*current_) != '=')
+                    {
+                        text[count++] = next_char();
+                    }
+
+                    if (count < text.size())
+                    {
+                        // the end of the text: only padding may follow
+                        while (current_ != end_)
+                        {
+                            if (auto const c{ next_char() }; c != '=')
+                            {
+                                throw std::invalid_argument(std::format("Invalid base64 character {:#04x} after padding.", c));
+                            }
+                        }
+
+                        if (count == 0)
+                        {
+                            quantum_begin_ = current_;
+                            return;
+                        }
+
+                        if (count == 1)
+                        {
+                            throw std::invalid_argument("Truncated base64 input.");
+                        }
+                    }
+
+                    decode_base64_quantum({ text.data(), count }, bytes_.data());
+                    size_ = static_cast<uint8_t>(count - 1);
+                }
+                else
+                {
+                    auto const high{ hex_digit_value(next_char()) };
+                    if (current_ == end_)
+                    {
+                        throw std::invalid_argument("Odd number of hex digits.");
+                    }
+
+                    auto const value{ high << 4 | hex_digit_value(next_char()) };
+                    if (value > 0xFF)
+                    {
+                        throw std::invalid_argument("Invalid hex digit in encoded input.");
+                    }
+
+                    bytes_[0] = static_cast<uint8_t>(value);
+                    size_ = 1;
+                }
+            }
+        };
+
+        /**
+         * A view of the bytes that hex or base64 text decodes to.
+         *
+         * Piped into a hash, contiguous text is decoded a chunk at a time
+         * straight into the hash's staging buffer, so the decoded bytes
+         * never exist as a whole.
+         *
+         * @tparam V The view of the text.
+         * @tparam F The text format: hex, hex_upper, or base64url.
+         */
+        template<encoded_range V, sph::hash_format F>
+            requires std::ranges::view<V>
+        class decode_view : public std::ranges::view_interface<decode_view<V, F>>
+        {
+            static_assert(is_text_format(F), "decode needs a text hash format: hex, hex_upper, or base64url.");
+            V input_;
+        public:
+            decode_view() = default;
+
+            explicit decode_view(V input)
+                : input_{ std::move(input) }
+            {
+            }
+
+            auto begin() const -> decode_iterator<V, F>
+            {
+                return { std::ranges::begin(input_), std::ranges::end(input_) };
+            }
+
+            // ReSharper disable once CppMemberFunctionMayBeStatic
+            auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+        };
+
+        /**
+         * Functor that, given a range of text, provides a decoded view of it.
+         * @tparam F The text format: hex, hex_upper, or base64url.
+         */
+        template<sph::hash_format F>
+        class decode_fn : public std::ranges::range_adaptor_closure<decode_fn<F>>
+        {
+        public:
+            template <std::ranges::viewable_range R>
+                requires encoded_range<std::views::all_t<R>>
+            [[nodiscard]] constexpr auto operator()(R&& range) const -> decode_view<std::views::all_t<R>, F>
+            {
+                return decode_view<std::views::all_t<R>, F>{ std::views::all(std::forward<R>(range)) };
+            }
+        };
+    }
+}
+
+template <typename V, sph::hash_format F>
+inline constexpr bool std::ranges::enable_borrowed_range<sph::ranges::views::detail::decode_view<V, F>> = std::ranges::enable_borrowed_range<V>;
+
+namespace sph::views
+{
+    /**
+     * A range adaptor that decodes hex or base64 text into its bytes.
+     *
+     * Hex is read in either case. Base64 may use the standard or the url
+     * alphabet, with or without '=' padding. Text that isn't validly
+     * encoded throws std::invalid_argument when it is read.
+     *
+     * Piped on into <code>sph::views::hash</code>, contiguous text (a
+     * std::string, a std::string_view, ...) is decoded a chunk at a time
+     * straight into the hash's staging buffer.
+     *
+     * @tparam F The text format: hex, hex_upper, or base64url.
+     * @return a functor that takes a range of text and returns a view of the
+     * decoded bytes.
+     */
+    template<sph::hash_format F>
+    auto decode() -> sph::ranges::views::detail::decode_fn<F>
+    {
+        return sph::ranges::views::detail::decode_fn<F>{};
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <type_traits>
+#include <sph/hash_algorithm.h>
+#include <sph/ranges/views/detail/blake2_parallel.h>
+#include <sph/ranges/views/detail/blake2b.h>
+#include <sph/ranges/views/detail/blake2s.h>
+#include <sph/ranges/views/detail/blake3.h>
+#include <sph/ranges/views/detail/git_object.h>
+#include <sph/ranges/views/detail/kangaroo_twelve.h>
+#include <sph/ranges/views/detail/keccak_xof.h>
+#include <sph/ranges/views/detail/parallel_hash.h>
+#include <sph/ranges/views/detail/poly1305.h>
+#include <sph/ranges/views/detail/sha1.h>
+#include <sph/ranges/views/detail/sha256.h>
+#include <sph/ranges/views/detail/sha3_256.h>
+#include <sph/ranges/views/detail/sha3_512.h>
+#include <sph/ranges/views/detail/sha512.h>
+#include <sph/ranges/views/detail/siphash.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * Maps a hash algorithm to the detail hash that implements it.
+     * @tparam A The hash algorithm.
+     */
+    template <sph::hash_algorithm A>
+    using algorithm_hash_t =
+        std::conditional_t<A == sph::hash_algorithm::blake2b, blake2b,
+        std::conditional_t<A == sph::hash_algorithm::sha512, sha512,
+        std::conditional_t<A == sph::hash_algorithm::sha256, sha256,
+        std::conditional_t<A == sph::hash_algorithm::sha3_256, sha3_256,
+        std::conditional_t<A == sph::hash_algorithm::sha3_512, sha3_512,
+        std::conditional_t<A == sph::hash_algorithm::blake3, blake3,
+        std::conditional_t<A == sph::hash_algorithm::siphash24, siphash24,
+        std::conditional_t<A == sph::hash_algorithm::siphashx24, siphashx24,
+        std::conditional_t<A == sph::hash_algorithm::poly1305, poly1305,
+        std::conditional_t<A == sph::hash_algorithm::blake2s, blake2s,
+        std::conditional_t<A == sph::hash_algorithm::blake2bp, blake2bp,
+        std::conditional_t<A == sph::hash_algorithm::blake2sp, blake2sp,
+        std::conditional_t<A == sph::hash_algorithm::k12, k12,
+        std::conditional_t<A == sph::hash_algorithm::turboshake128, turboshake128,
+        std::conditional_t<A == sph::hash_algorithm::turboshake256, turboshake256,
+        std::conditional_t<A == sph::hash_algorithm::shake128, shake128,
+        std::conditional_t<A == sph::hash_algorithm::shake256, shake256,
+        std::conditional_t<A == sph::hash_algorithm::parallelhash128, parallelhash128,
+        std::conditional_t<A == sph::hash_algorithm::parallelhash256, parallelhash256,
+        std::conditional_t<A == sph::hash_algorithm::sha512_256, sha512_256,
+        std::conditional_t<A == sph::hash_algorithm::sha512_224, sha512_224,
+        std::conditional_t<A == sph::hash_algorithm::sha1, sha1,
+        std::conditional_t<A == sph::hash_algorithm::git_sha1, git_sha1,
+        std::conditional_t<A == sph::hash_algorithm::git_sha256, git_sha256, void>>>>>>>>>>>>>>>>>>>>>>>>;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <type_traits>
+#include <sph/blake2b_parameters.h>
+#include <sph/blake2s_parameters.h>
+#include <sph/git_object_parameters.h>
+#include <sph/hash_algorithm.h>
+#include <sph/k12_parameters.h>
+#include <sph/parallel_hash_parameters.h>
+#include <sph/poly1305_parameters.h>
+#include <sph/siphash_parameters.h>
+
+namespace sph::ranges::views::detail
+{
+    struct no_algorithm_parameters {};
+
+    /**
+     * Maps a hash algorithm to the parameter type it accepts.
+     *
+     * Algorithms without parameters map to no_algorithm_parameters.
+     * @tparam A The hash algorithm.
+     */
+    template <sph::hash_algorithm A>
+    struct algorithm_parameters { using type = no_algorithm_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::blake2b> { using type = sph::blake2b_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::blake2s> { using type = sph::blake2s_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::blake2bp> { using type = sph::blake2b_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::blake2sp> { using type = sph::blake2s_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::siphash24> { using type = sph::siphash_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::siphashx24> { using type = sph::siphash_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::poly1305> { using type = sph::poly1305_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::k12> { using type = sph::k12_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::parallelhash128> { using type = sph::parallel_hash_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::parallelhash256> { using type = sph::parallel_hash_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::git_sha1> { using type = sph::git_object_parameters; };
+
+    template <>
+    struct algorithm_parameters<sph::hash_algorithm::git_sha256> { using type = sph::git_object_parameters; };
+
+    template <sph::hash_algorithm A>
+    using algorithm_parameters_t = typename algorithm_parameters<A>::type;
+
+    /**
+     * True if the hash algorithm accepts parameters (key, salt, etc.).
+     * @tparam A The hash algorithm.
+     */
+    template <sph::hash_algorithm A>
+    concept has_algorithm_parameters = !std::is_same_v<algorithm_parameters_t<A>, no_algorithm_parameters>;
+}
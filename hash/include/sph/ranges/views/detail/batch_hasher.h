@@ -0,0 +1,217 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_format.h>
+#include <sph/hash_param.h>
+#include <sph/hash_site.h>
+#include <sph/ranges/views/detail/algorithm_hash.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/get_hash_size.h>
+#include <sph/ranges/views/detail/hash_util.h>
+#include <sph/ranges/views/detail/process_util.h>
+#include <sph/ranges/views/detail/text_encoding.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * A range of messages, each a range of hashable values.
+     */
+    template <typename M>
+    concept message_range = std::ranges::input_range<M>
+        && hash_range<std::ranges::range_reference_t<M>>;
+
+    /**
+     * Copy a finalized hash's digest out; extendable output a block at a
+     * time.
+     */
+    template<basic_hash H>
+    auto read_digest(H& hasher, std::span<uint8_t> digest) -> void
+    {
+        auto block{ hasher.hash() };
+        auto copied{ std::min(static_cast<size_t>(std::ranges::size(block)), digest.size()) };
+        std::ranges::copy_n(std::ranges::begin(block), static_cast<ptrdiff_t>(copied), digest.begin());
+        if constexpr (extendable_hash<H>)
+        {
+            while (copied < digest.size())
+            {
+                hasher.next_block();
+                block = hasher.hash();
+                auto const take{ std::min(static_cast<size_t>(std::ranges::size(block)), digest.size() - copied) };
+                std::ranges::copy_n(std::ranges::begin(block), static_cast<ptrdiff_t>(take), digest.begin() + static_cast<ptrdiff_t>(copied));
+                copied += take;
+            }
+        }
+    }
+
+    /**
+     * Hashes one message after another into raw, separate digests.
+     *
+     * The hash state is initialized, and its parameters validated, once;
+     * each message starts from a copy of that state rather than going
+     * through a hash_view, hash_iterator, and hash_processor of its own.
+     * Git object hashes are the exception: their initial state holds the
+     * message size, so it is built for each message.
+     *
+     * Everything that hashes a batch goes through hash(), so a kernel that
+     * hashes several messages at once can be slotted in here.
+     *
+     * @tparam A The hash algorithm.
+     */
+    template<sph::hash_algorithm A>
+    class batch_hasher
+    {
+        using hash_t = algorithm_hash_t<A>;
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+        size_t digest_size_;
+        [[no_unique_address]] algorithm_parameters_t parameters_;
+        hash_t initial_;
+    public:
+        /**
+         * @param target_hash_size The digest size; zero for the algorithm's
+         * default. Throws std::invalid_argument if it is too large.
+         * @param parameters The algorithm parameters (key, salt, etc.).
+         */
+        explicit batch_hasher(size_t target_hash_size, algorithm_parameters_t parameters = {})
+            : digest_size_{ get_hash_size<A, sph::hash_format::raw, sph::hash_site::separate>(target_hash_size) }
+            , parameters_{ parameters }
+            , initial_{ make_hash(digest_size_, parameters_, 0) }
+        {
+        }
+
+        auto digest_size() const -> size_t
+        {
+            return digest_size_;
+        }
+
+        /**
+         * Hash one message.
+         * @param message The message; its elements are hashed as their bytes.
+         * @param digest Where to write the digest; digest_size() bytes.
+         */
+        template<hash_range M>
+        auto hash(M&& message, std::span<uint8_t> digest) const -> void
+        {
+            if constexpr (sph::hash_param<A>::git_object())
+            {
+                static_assert(std::ranges::forward_range<M>, "A git object hash needs the message size up front, so each message must be a forward range.");
+                auto const object_size{ static_cast<uint64_t>(std::ranges::distance(message)) * sizeof(std::ranges::range_value_t<M>) };
+                auto hasher{ make_hash(digest_size_, parameters_, object_size) };
+                absorb(hasher, std::forward<M>(message));
+                read_digest(hasher, digest);
+            }
+            else
+            {
+                auto hasher{ initial_ };
+                absorb(hasher, std::forward<M>(message));
+                read_digest(hasher, digest);
+            }
+        }
+
+    private:
+        static auto make_hash(size_t digest_size, algorithm_parameters_t const& parameters, uint64_t object_size) -> hash_t
+        {
+            if constexpr (sph::hash_param<A>::git_object())
+            {
+                return hash_t{ digest_size, parameters, object_size };
+            }
+            else if constexpr (has_algorithm_parameters<A>)
+            {
+                return hash_t{ digest_size, parameters };
+            }
+            else
+            {
+                return hash_t{ digest_size };
+            }
+        }
+
+        /**
+         * Contiguous messages go to the hash in one call and contiguous
+         * encoded text is decoded into it; anything else is staged a chunk
+         * at a time, or copied in whole if its size is known to fit in one
+         * chunk.
+         */
+        template<typename M>
+        static auto absorb(hash_t& hasher, M&& message) -> void
+        {
+            using value_t = std::remove_cvref_t<std::ranges::range_value_t<M>>;
+            if constexpr (std::ranges::contiguous_range<M> && std::ranges::sized_range<M>)
+            {
+                auto const count{ static_cast<size_t>(std::ranges::size(message)) };
+                std::span<uint8_t const> bytes{};
+                if (count != 0)
+                {
+                    bytes = { reinterpret_cast<uint8_t const*>(std::ranges::data(message)), count * sizeof(value_t) };
+                }
+
+                hasher.final(bytes);
+            }
+            else if constexpr (contiguous_encoded_iterator<std::ranges::iterator_t<M>>)
+            {
+                // encoded text: decode it a chunk at a time straight into the hash
+                text_decoder<std::ranges::iterator_t<M>::encoding> decoder{ std::ranges::begin(message).encoded() };
+                std::array<uint8_t, hash_t::chunk_size> chunk{};
+                while (true)
+                {
+                    auto const count{ decoder.read(chunk) };
+                    if (count < chunk.size() || decoder.done())
+                    {
+                        hasher.final(std::span<uint8_t const>{ chunk.data(), count });
+                        return;
+                    }
+
+                    hasher.update(std::span<uint8_t const, hash_t::chunk_size>{ chunk });
+                }
+            }
+            else
+            {
+                std::array<uint8_t, hash_t::chunk_size> chunk{};
+                if constexpr (std::ranges::sized_range<M>)
+                {
+                    // a short message fits in one chunk: copy it in whole and finish
+                    if (auto const byte_count{ static_cast<size_t>(std::ranges::size(message)) * sizeof(value_t) }; byte_count <= hash_t::chunk_size)
+                    {
+                        auto out{ chunk.data() };
+                        for (auto&& element : message)
+                        {
+                            value_t const value{ element };
+                            std::memcpy(out, &value, sizeof(value_t));
+                            out += sizeof(value_t);
+                        }
+
+                        hasher.final(std::span<uint8_t const>{ chunk.data(), byte_count });
+                        return;
+                    }
+                }
+
+                size_t filled{};
+                for (auto&& element : message)
+                {
+                    value_t const value{ element };
+                    std::span<uint8_t const> bytes{ reinterpret_cast<uint8_t const*>(&value), sizeof(value_t) };
+                    while (!bytes.empty())
+                    {
+                        auto const take{ std::min(hash_t::chunk_size - filled, bytes.size()) };
+                        std::copy_n(bytes.begin(), take, chunk.begin() + static_cast<ptrdiff_t>(filled));
+                        filled += take;
+                        bytes = bytes.subspan(take);
+                        if (filled == hash_t::chunk_size)
+                        {
+                            hasher.update(std::span<uint8_t const, hash_t::chunk_size>{ chunk });
+                            filled = 0;
+                        }
+                    }
+                }
+
+                hasher.final(std::span<uint8_t const>{ chunk.data(), filled });
+            }
+        }
+    };
+}
@@ -0,0 +1,293 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * Portable BLAKE2 compression and padding shared by the BLAKE2 variants
+     * libsodium does not provide.
+     *
+     * BLAKE2b and BLAKE2s differ only in word size, rotation amounts, round
+     * count, and IV, so one implementation covers both. Unlike libsodium's
+     * BLAKE2b, the full parameter block (fanout, depth, node offset, ...) is
+     * exposed so tree modes can build their leaves and roots from it.
+     *
+     * @tparam W uint64_t for BLAKE2b, uint32_t for BLAKE2s.
+     */
+    template<typename W>
+        requires (std::same_as<W, uint64_t> || std::same_as<W, uint32_t>)
+    class blake2_engine
+    {
+    public:
+        static constexpr size_t block_size{ 16 * sizeof(W) };
+        static constexpr size_t max_hash_size{ 8 * sizeof(W) };
+        static constexpr size_t max_key_size{ 8 * sizeof(W) };
+        static constexpr size_t salt_size{ 2 * sizeof(W) };
+        static constexpr size_t personal_size{ 2 * sizeof(W) };
+        using parameter_block = std::array<uint8_t, 8 * sizeof(W)>;
+
+        /**
+         * Values for the fields of the BLAKE2 parameter block.
+         *
+         * Salt and personalization shorter than their full size are
+         * zero-padded; the defaults describe sequential (non-tree) hashing.
+         */
+        struct parameters
+        {
+            size_t digest_length{ max_hash_size };
+            size_t key_length{};
+            std::span<uint8_t const> salt{};
+            std::span<uint8_t const> personal{};
+            uint8_t fanout{ 1 };
+            uint8_t depth{ 1 };
+            uint32_t leaf_length{};
+            uint64_t node_offset{};
+            uint8_t node_depth{};
+            uint8_t inner_length{};
+        };
+
+        static constexpr bool is_64_bit{ std::same_as<W, uint64_t> };
+        static constexpr size_t round_count{ is_64_bit ? 12 : 10 };
+        static constexpr std::array<int, 4> rotations{ is_64_bit ? std::array<int, 4>{ 32, 24, 16, 63 } : std::array<int, 4>{ 16, 12, 8, 7 } };
+        static constexpr std::array<W, 8> iv{ []() -> std::array<W, 8>
+            {
+                if constexpr (is_64_bit)
+                {
+                    return {
+                        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+                        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL };
+                }
+                else
+                {
+                    return {
+                        0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+                        0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U };
+                }
+            }() };
+        static constexpr std::array<std::array<uint8_t, 16>, 10> sigma{ {
+            {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+            { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+            { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+            {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+            {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+            {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+            { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+            { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+            {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+            { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 } } };
+
+    private:
+        std::array<W, 8> h_;
+        std::array<W, 2> t_{};
+        std::array<uint8_t, block_size> buffer_{};
+        size_t buffer_size_{};
+        size_t digest_length_;
+        bool last_node_;
+
+    public:
+        /**
+         * Start a BLAKE2 hash.
+         *
+         * @param p the parameter block fields.
+         * @param key the key, or empty for an unkeyed hash; must be
+         * p.key_length bytes long (a tree root passes an empty key with a
+         * non-zero key_length).
+         * @param last_node true if this is the last node at its depth of a
+         * tree hash.
+         */
+        explicit blake2_engine(parameters const& p, std::span<uint8_t const> key = {}, bool last_node = false)
+            : h_{ initial_state(p) }
+            , digest_length_{ p.digest_length }
+            , last_node_{ last_node }
+        {
+            if (!key.empty())
+            {
+                std::ranges::copy(key, buffer_.begin());
+                buffer_size_ = block_size;
+            }
+        }
+
+        /**
+         * Absorb data. The last block is held back until final() because
+         * it must be compressed with the finalization flag.
+         */
+        auto update(std::span<uint8_t const> data) -> void
+        {
+            while (!data.empty())
+            {
+                if (buffer_size_ == block_size)
+                {
+                    increment_counter(block_size);
+                    compress(h_, t_, false, last_node_, buffer_);
+                    buffer_size_ = 0;
+                }
+
+                auto const take{ std::min(block_size - buffer_size_, data.size()) };
+                std::ranges::copy(data.first(take), buffer_.begin() + static_cast<ptrdiff_t>(buffer_size_));
+                buffer_size_ += take;
+                data = data.subspan(take);
+            }
+        }
+
+        /**
+         * Finish the hash and write the digest.
+         *
+         * @param out receives min(out.size(), digest length) bytes.
+         */
+        auto final(std::span<uint8_t> out) -> void
+        {
+            increment_counter(buffer_size_);
+            std::fill(buffer_.begin() + static_cast<ptrdiff_t>(buffer_size_), buffer_.end(), uint8_t{ 0 });
+            compress(h_, t_, true, last_node_, buffer_);
+            auto const digest{ chaining_value_bytes(h_) };
+            std::copy_n(digest.begin(), std::min({ out.size(), digest_length_, digest.size() }), out.begin());
+        }
+
+        /**
+         * Get the initial chaining value for a parameter block.
+         */
+        static auto initial_state(parameters const& p) -> std::array<W, 8>
+        {
+            parameter_block block{};
+            block[0] = static_cast<uint8_t>(p.digest_length);
+            block[1] = static_cast<uint8_t>(p.key_length);
+            block[2] = p.fanout;
+            block[3] = p.depth;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                block[4 + i] = static_cast<uint8_t>(p.leaf_length >> (8 * i));
+            }
+
+            // the node offset is 64 bits in BLAKE2b and 48 bits in BLAKE2s
+            constexpr size_t node_offset_size{ is_64_bit ? 8 : 6 };
+            for (size_t i = 0; i < node_offset_size; ++i)
+            {
+                block[8 + i] = static_cast<uint8_t>(p.node_offset >> (8 * i));
+            }
+
+            block[8 + node_offset_size] = p.node_depth;
+            block[9 + node_offset_size] = p.inner_length;
+            std::ranges::copy(p.salt.first(std::min(p.salt.size(), salt_size)), block.begin() + (4 * sizeof(W)));
+            std::ranges::copy(p.personal.first(std::min(p.personal.size(), personal_size)), block.begin() + (6 * sizeof(W)));
+
+            std::array<W, 8> h{};
+            for (size_t i = 0; i < h.size(); ++i)
+            {
+                h[i] = iv[i] ^ load(std::span<uint8_t const, sizeof(W)>{ block.data() + (i * sizeof(W)), sizeof(W) });
+            }
+
+            return h;
+        }
+
+        /**
+         * Serialize a chaining value as the little-endian digest bytes.
+         */
+        static auto chaining_value_bytes(std::array<W, 8> const& h) -> std::array<uint8_t, max_hash_size>
+        {
+            std::array<uint8_t, max_hash_size> digest{};
+            for (size_t i = 0; i < h.size(); ++i)
+            {
+                store(h[i], std::span<uint8_t, sizeof(W)>{ digest.data() + (i * sizeof(W)), sizeof(W) });
+            }
+
+            return digest;
+        }
+
+        /**
+         * The BLAKE2 compression function F.
+         *
+         * @param h the chaining value to update.
+         * @param t the byte counter, including this block.
+         * @param final_block true for the last block of the node.
+         * @param last_node true if the node is the last at its tree depth.
+         * @param block the message block.
+         */
+        static auto compress(std::array<W, 8>& h, std::array<W, 2> const& t, bool final_block, bool last_node, std::span<uint8_t const, block_size> block) -> void
+        {
+            std::array<W, 16> m{};
+            for (size_t i = 0; i < m.size(); ++i)
+            {
+                m[i] = load(std::span<uint8_t const, sizeof(W)>{ block.data() + (i * sizeof(W)), sizeof(W) });
+            }
+
+            std::array<W, 16> v{};
+            std::copy(h.begin(), h.end(), v.begin());
+            std::copy(iv.begin(), iv.end(), v.begin() + 8);
+            v[12] ^= t[0];
+            v[13] ^= t[1];
+            if (final_block)
+            {
+                v[14] = static_cast<W>(~v[14]);
+                if (last_node)
+                {
+                    v[15] = static_cast<W>(~v[15]);
+                }
+            }
+
+            for (size_t round = 0; round < round_count; ++round)
+            {
+                auto const& s{ sigma[round % sigma.size()] };
+                g(v, 0, 4,  8, 12, m[s[0]], m[s[1]]);
+                g(v, 1, 5,  9, 13, m[s[2]], m[s[3]]);
+                g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+                g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+                g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+                g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+                g(v, 2, 7,  8, 13, m[s[12]], m[s[13]]);
+                g(v, 3, 4,  9, 14, m[s[14]], m[s[15]]);
+            }
+
+            for (size_t i = 0; i < h.size(); ++i)
+            {
+                h[i] ^= v[i] ^ v[i + 8];
+            }
+        }
+
+    private:
+        static auto load(std::span<uint8_t const, sizeof(W)> bytes) -> W
+        {
+            W ret{};
+            for (size_t i = 0; i < sizeof(W); ++i)
+            {
+                ret |= static_cast<W>(static_cast<W>(bytes[i]) << (8 * i));
+            }
+
+            return ret;
+        }
+
+        static auto store(W value, std::span<uint8_t, sizeof(W)> bytes) -> void
+        {
+            for (size_t i = 0; i < sizeof(W); ++i)
+            {
+                bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        auto increment_counter(size_t byte_count) -> void
+        {
+            t_[0] += static_cast<W>(byte_count);
+            if (t_[0] < static_cast<W>(byte_count))
+            {
+                ++t_[1];
+            }
+        }
+
+        static auto g(std::array<W, 16>& v, size_t a, size_t b, size_t c, size_t d, W x, W y) -> void
+        {
+            v[a] = v[a] + v[b] + x;
+            v[d] = std::rotr(static_cast<W>(v[d] ^ v[a]), rotations[0]);
+            v[c] = v[c] + v[d];
+            v[b] = std::rotr(static_cast<W>(v[b] ^ v[c]), rotations[1]);
+            v[a] = v[a] + v[b] + y;
+            v[d] = std::rotr(static_cast<W>(v[d] ^ v[a]), rotations[2]);
+            v[c] = v[c] + v[d];
+            v[b] = std::rotr(static_cast<W>(v[b] ^ v[c]), rotations[3]);
+        }
+    };
+}
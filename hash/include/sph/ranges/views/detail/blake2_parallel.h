@@ -0,0 +1,409 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include <sph/blake2b_parameters.h>
+#include <sph/blake2s_parameters.h>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/ranges/views/detail/blake2_engine.h>
+
+namespace sph::ranges::views::detail
+{
+#if defined(__AVX2__)
+    /**
+     * AVX2 operations on one BLAKE2 state word across all leaves: four
+     * BLAKE2b leaves or eight BLAKE2s leaves fill a 256-bit register.
+     */
+    template<typename W>
+    struct blake2_avx2_ops;
+
+    template<>
+    struct blake2_avx2_ops<uint64_t>
+    {
+        static auto add(__m256i a, __m256i b) -> __m256i { return _mm256_add_epi64(a, b); }
+        static auto broadcast(uint64_t x) -> __m256i { return _mm256_set1_epi64x(static_cast<long long>(x)); }
+        template<int N>
+        static auto rotr(__m256i x) -> __m256i { return _mm256_or_si256(_mm256_srli_epi64(x, N), _mm256_slli_epi64(x, 64 - N)); }
+
+        /**
+         * Load word k of each leaf's block from a stripe of consecutive
+         * leaf blocks.
+         */
+        static auto load_word(uint8_t const* stripe, size_t k) -> __m256i
+        {
+            constexpr long long block{ 128 };
+            return _mm256_i64gather_epi64(
+                reinterpret_cast<long long const*>(stripe + (k * sizeof(uint64_t))),
+                _mm256_setr_epi64x(0, block, 2 * block, 3 * block),
+                1);
+        }
+    };
+
+    template<>
+    struct blake2_avx2_ops<uint32_t>
+    {
+        static auto add(__m256i a, __m256i b) -> __m256i { return _mm256_add_epi32(a, b); }
+        static auto broadcast(uint32_t x) -> __m256i { return _mm256_set1_epi32(static_cast<int>(x)); }
+        template<int N>
+        static auto rotr(__m256i x) -> __m256i { return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N)); }
+
+        static auto load_word(uint8_t const* stripe, size_t k) -> __m256i
+        {
+            constexpr int block{ 64 };
+            return _mm256_i32gather_epi32(
+                reinterpret_cast<int const*>(stripe + (k * sizeof(uint32_t))),
+                _mm256_setr_epi32(0, block, 2 * block, 3 * block, 4 * block, 5 * block, 6 * block, 7 * block),
+                1);
+        }
+    };
+#endif
+
+    /**
+     * BLAKE2bp and BLAKE2sp: the BLAKE2 tree modes with a fanout of 4
+     * (BLAKE2b) or 8 (BLAKE2s) leaves and a single root.
+     *
+     * Consecutive input blocks go round-robin to the leaves, so one stripe
+     * of input holds exactly one block for each leaf. With AVX2 enabled at
+     * compile time, each stripe is compressed for all leaves at once with
+     * each leaf in its own SIMD lane; otherwise leaves are compressed one
+     * after the other with the portable blake2_engine compression.
+     *
+     * Salt and personalization, if given, are applied to every node. The
+     * standard BLAKE2bp/BLAKE2sp leave them empty.
+     *
+     * @tparam A hash_algorithm::blake2bp or hash_algorithm::blake2sp.
+     */
+    template<sph::hash_algorithm A>
+        requires (A == sph::hash_algorithm::blake2bp || A == sph::hash_algorithm::blake2sp)
+    class blake2_parallel
+    {
+        static constexpr bool is_blake2bp{ A == sph::hash_algorithm::blake2bp };
+        using word_t = std::conditional_t<is_blake2bp, uint64_t, uint32_t>;
+        using engine_t = blake2_engine<word_t>;
+        using parameters_t = std::conditional_t<is_blake2bp, sph::blake2b_parameters, sph::blake2s_parameters>;
+        static constexpr size_t leaf_count{ is_blake2bp ? 4 : 8 };
+        static constexpr size_t block_size{ engine_t::block_size };
+        static constexpr size_t stripe_size{ leaf_count * block_size };
+        static constexpr std::string_view name{ is_blake2bp ? "BLAKE2bp" : "BLAKE2sp" };
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<A>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<A>::chunk_size() };
+        static constexpr size_t salt_size{ engine_t::salt_size };
+        static constexpr size_t personal_size{ engine_t::personal_size };
+    private:
+        // Leaf chaining values stored word-major so word k of every leaf is
+        // one contiguous (SIMD register sized) row.
+        alignas(32) std::array<std::array<word_t, leaf_count>, 8> h_;
+        // Bytes each leaf has compressed so far; every leaf compresses one
+        // block per stripe so they stay equal until finalization.
+        uint64_t leaf_byte_count_{};
+        // Two stripes: one filling and, possibly, one full but held back.
+        // A full stripe can only be compressed once every leaf is known to
+        // get more input because each leaf's last block needs the
+        // finalization flag.
+        std::array<std::array<uint8_t, stripe_size>, 2> stripes_{};
+        size_t current_{};
+        size_t current_size_{};
+        bool pending_{};
+        size_t key_size_;
+        std::array<uint8_t, engine_t::salt_size> salt_{};
+        size_t salt_size_;
+        std::array<uint8_t, engine_t::personal_size> personal_{};
+        size_t personal_size_;
+        std::array<uint8_t, hash_size> hash_{};
+        size_t hash_size_;
+    public:
+        explicit blake2_parallel(size_t hash_byte_count, parameters_t parameters = {})
+            : h_{ init_state(hash_byte_count, parameters) }
+            , key_size_{ parameters.key.size() }
+            , salt_size_{ parameters.salt.size() }
+            , personal_size_{ parameters.personal.size() }
+            , hash_size_{ hash_byte_count }
+        {
+            std::ranges::copy(parameters.salt, salt_.begin());
+            std::ranges::copy(parameters.personal, personal_.begin());
+            if (key_size_ != 0)
+            {
+                // A keyed leaf starts with the zero-padded key as its first
+                // block, so the first stripe is one key block per leaf.
+                for (size_t leaf = 0; leaf < leaf_count; ++leaf)
+                {
+                    std::ranges::copy(parameters.key, stripes_[0].begin() + static_cast<ptrdiff_t>(leaf * block_size));
+                }
+
+                current_size_ = stripe_size;
+            }
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return { hash_.data(), hash_size_ };
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            absorb(data);
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            absorb(data);
+            std::array<uint8_t, leaf_count * engine_t::max_hash_size> leaf_hashes{};
+            auto const& current{ stripes_[current_] };
+            auto const& previous{ stripes_[current_ ^ 1] };
+            for (size_t leaf = 0; leaf < leaf_count; ++leaf)
+            {
+                std::array<word_t, 8> h{};
+                for (size_t k = 0; k < h.size(); ++k)
+                {
+                    h[k] = h_[k][leaf];
+                }
+
+                uint64_t count{ leaf_byte_count_ };
+                auto const leaf_offset{ leaf * block_size };
+                auto const tail_size{ current_size_ > leaf_offset ? std::min(current_size_ - leaf_offset, block_size) : size_t{ 0 } };
+                bool const last_node{ leaf == leaf_count - 1 };
+                if (pending_)
+                {
+                    bool const pending_is_last{ tail_size == 0 };
+                    count += block_size;
+                    engine_t::compress(h, counter(count), pending_is_last, last_node, block_of(previous, leaf_offset));
+                    if (pending_is_last)
+                    {
+                        store_leaf_hash(h, leaf, leaf_hashes);
+                        continue;
+                    }
+                }
+
+                std::array<uint8_t, block_size> last_block{};
+                std::copy_n(current.begin() + static_cast<ptrdiff_t>(leaf_offset), tail_size, last_block.begin());
+                count += tail_size;
+                engine_t::compress(h, counter(count), true, last_node, last_block);
+                store_leaf_hash(h, leaf, leaf_hashes);
+            }
+
+            // the root is keyed through key_length only; it has no key block
+            engine_t root{
+                node_parameters(hash_size_, 1, 0, key_size_,
+                    std::span<uint8_t const>{ salt_.data(), salt_size_ },
+                    std::span<uint8_t const>{ personal_.data(), personal_size_ }),
+                {},
+                true };
+            root.update(leaf_hashes);
+            root.final(hash_);
+        }
+
+    private:
+        /**
+         * Leaf parameter blocks carry the requested digest length like the
+         * root's; every leaf still outputs a full inner_length chaining value.
+         */
+        static auto init_state(size_t hash_byte_count, parameters_t const& parameters) -> std::array<std::array<word_t, leaf_count>, 8>
+        {
+            validate_parameters(parameters);
+            std::array<std::array<word_t, leaf_count>, 8> h{};
+            for (size_t leaf = 0; leaf < leaf_count; ++leaf)
+            {
+                auto const leaf_h{ engine_t::initial_state(
+                    node_parameters(hash_byte_count, 0, leaf, parameters.key.size(), parameters.salt, parameters.personal)) };
+                for (size_t k = 0; k < leaf_h.size(); ++k)
+                {
+                    h[k][leaf] = leaf_h[k];
+                }
+            }
+
+            return h;
+        }
+
+        static auto node_parameters(
+            size_t digest_length,
+            uint8_t node_depth,
+            uint64_t node_offset,
+            size_t key_length,
+            std::span<uint8_t const> salt,
+            std::span<uint8_t const> personal) -> typename engine_t::parameters
+        {
+            return typename engine_t::parameters{
+                .digest_length = digest_length,
+                .key_length = key_length,
+                .salt = salt,
+                .personal = personal,
+                .fanout = static_cast<uint8_t>(leaf_count),
+                .depth = 2,
+                .leaf_length = 0,
+                .node_offset = node_offset,
+                .node_depth = node_depth,
+                .inner_length = static_cast<uint8_t>(engine_t::max_hash_size) };
+        }
+
+        static auto counter(uint64_t byte_count) -> std::array<word_t, 2>
+        {
+            if constexpr (is_blake2bp)
+            {
+                return { byte_count, 0 };
+            }
+            else
+            {
+                return { static_cast<uint32_t>(byte_count), static_cast<uint32_t>(byte_count >> 32) };
+            }
+        }
+
+        static auto block_of(std::array<uint8_t, stripe_size> const& stripe, size_t offset) -> std::span<uint8_t const, block_size>
+        {
+            return std::span<uint8_t const, block_size>{ stripe.data() + offset, block_size };
+        }
+
+        static auto store_leaf_hash(std::array<word_t, 8> const& h, size_t leaf, std::array<uint8_t, leaf_count * engine_t::max_hash_size>& leaf_hashes) -> void
+        {
+            auto const bytes{ engine_t::chaining_value_bytes(h) };
+            std::ranges::copy(bytes, leaf_hashes.begin() + static_cast<ptrdiff_t>(leaf * engine_t::max_hash_size));
+        }
+
+        auto absorb(std::span<uint8_t const> data) -> void
+        {
+            while (!data.empty())
+            {
+                if (current_size_ == stripe_size)
+                {
+                    // a full current stripe always releases any pending one
+                    // first (its last leaf has data), so the other slot is free
+                    pending_ = true;
+                    current_ ^= 1;
+                    current_size_ = 0;
+                }
+
+                auto const take{ std::min(stripe_size - current_size_, data.size()) };
+                std::copy_n(data.begin(), take, stripes_[current_].begin() + static_cast<ptrdiff_t>(current_size_));
+                current_size_ += take;
+                data = data.subspan(take);
+                if (pending_ && current_size_ > stripe_size - block_size)
+                {
+                    compress_stripe(stripes_[current_ ^ 1]);
+                    pending_ = false;
+                }
+            }
+        }
+
+        /**
+         * Compress one block into every leaf, none of them final.
+         */
+        auto compress_stripe(std::array<uint8_t, stripe_size> const& stripe) -> void
+        {
+            leaf_byte_count_ += block_size;
+#if defined(__AVX2__)
+            using ops = blake2_avx2_ops<word_t>;
+            // plain arrays: std::array<__m256i> drops the vector type's
+            // alignment attribute (-Wignored-attributes)
+            __m256i m[16];
+            for (size_t k = 0; k < 16; ++k)
+            {
+                m[k] = ops::load_word(stripe.data(), k);
+            }
+
+            auto const t{ counter(leaf_byte_count_) };
+            __m256i v[16];
+            for (size_t k = 0; k < 8; ++k)
+            {
+                v[k] = _mm256_load_si256(reinterpret_cast<__m256i const*>(h_[k].data()));
+                v[k + 8] = ops::broadcast(engine_t::iv[k]);
+            }
+
+            v[12] = ops::broadcast(engine_t::iv[4] ^ t[0]);
+            v[13] = ops::broadcast(engine_t::iv[5] ^ t[1]);
+            auto g{ [&](size_t a, size_t b, size_t c, size_t d, __m256i x, __m256i y) -> void
+                {
+                    v[a] = ops::add(ops::add(v[a], v[b]), x);
+                    v[d] = ops::template rotr<engine_t::rotations[0]>(_mm256_xor_si256(v[d], v[a]));
+                    v[c] = ops::add(v[c], v[d]);
+                    v[b] = ops::template rotr<engine_t::rotations[1]>(_mm256_xor_si256(v[b], v[c]));
+                    v[a] = ops::add(ops::add(v[a], v[b]), y);
+                    v[d] = ops::template rotr<engine_t::rotations[2]>(_mm256_xor_si256(v[d], v[a]));
+                    v[c] = ops::add(v[c], v[d]);
+                    v[b] = ops::template rotr<engine_t::rotations[3]>(_mm256_xor_si256(v[b], v[c]));
+                } };
+            for (size_t round = 0; round < engine_t::round_count; ++round)
+            {
+                auto const& s{ engine_t::sigma[round % engine_t::sigma.size()] };
+                g(0, 4,  8, 12, m[s[0]], m[s[1]]);
+                g(1, 5,  9, 13, m[s[2]], m[s[3]]);
+                g(2, 6, 10, 14, m[s[4]], m[s[5]]);
+                g(3, 7, 11, 15, m[s[6]], m[s[7]]);
+                g(0, 5, 10, 15, m[s[8]], m[s[9]]);
+                g(1, 6, 11, 12, m[s[10]], m[s[11]]);
+                g(2, 7,  8, 13, m[s[12]], m[s[13]]);
+                g(3, 4,  9, 14, m[s[14]], m[s[15]]);
+            }
+
+            for (size_t k = 0; k < 8; ++k)
+            {
+                auto const h{ _mm256_load_si256(reinterpret_cast<__m256i const*>(h_[k].data())) };
+                _mm256_store_si256(reinterpret_cast<__m256i*>(h_[k].data()), _mm256_xor_si256(h, _mm256_xor_si256(v[k], v[k + 8])));
+            }
+#else
+            auto const t{ counter(leaf_byte_count_) };
+            for (size_t leaf = 0; leaf < leaf_count; ++leaf)
+            {
+                std::array<word_t, 8> h{};
+                for (size_t k = 0; k < h.size(); ++k)
+                {
+                    h[k] = h_[k][leaf];
+                }
+
+                engine_t::compress(h, t, false, false, block_of(stripe, leaf * block_size));
+                for (size_t k = 0; k < h.size(); ++k)
+                {
+                    h_[k][leaf] = h[k];
+                }
+            }
+#endif
+        }
+
+        static auto validate_parameters(parameters_t const& parameters) -> void
+        {
+            if (parameters.key.size() > engine_t::max_key_size)
+            {
+                throw std::invalid_argument(
+                    std::format("{} key length must be between 0 and {} bytes, got {}.",
+                        name,
+                        engine_t::max_key_size,
+                        parameters.key.size()));
+            }
+
+            if (!parameters.salt.empty() && parameters.salt.size() != salt_size)
+            {
+                throw std::invalid_argument(
+                    std::format("{} salt length must be 0 or {} bytes, got {}.",
+                        name,
+                        salt_size,
+                        parameters.salt.size()));
+            }
+
+            if (!parameters.personal.empty() && parameters.personal.size() != personal_size)
+            {
+                throw std::invalid_argument(
+                    std::format("{} personalization length must be 0 or {} bytes, got {}.",
+                        name,
+                        personal_size,
+                        parameters.personal.size()));
+            }
+        }
+    };
+
+    using blake2bp = blake2_parallel<sph::hash_algorithm::blake2bp>;
+    using blake2sp = blake2_parallel<sph::hash_algorithm::blake2sp>;
+}
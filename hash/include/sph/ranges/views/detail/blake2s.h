@@ -0,0 +1,99 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <sph/blake2s_parameters.h>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/ranges/views/detail/blake2_engine.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * BLAKE2s: the 32-bit-word BLAKE2 with a 64-byte block and up to a
+     * 32-byte digest. libsodium only provides BLAKE2b, so this runs the
+     * portable blake2_engine.
+     */
+    class blake2s
+    {
+        using engine_t = blake2_engine<uint32_t>;
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<sph::hash_algorithm::blake2s>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<sph::hash_algorithm::blake2s>::chunk_size() };
+        static constexpr size_t salt_size{ engine_t::salt_size };
+        static constexpr size_t personal_size{ engine_t::personal_size };
+    private:
+        engine_t engine_;
+        std::array<uint8_t, hash_size> hash_{};
+        size_t hash_size_;
+    public:
+        explicit blake2s(size_t hash_byte_count, sph::blake2s_parameters parameters = {})
+            : engine_{ init_engine(hash_byte_count, parameters) }
+            , hash_size_{ hash_byte_count }
+        {
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return { hash_.data(), hash_size_ };
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            engine_.update(data);
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            engine_.update(data);
+            engine_.final(hash_);
+        }
+
+    private:
+        static auto init_engine(size_t hash_byte_count, sph::blake2s_parameters parameters) -> engine_t
+        {
+            validate_parameters(parameters);
+            return engine_t{
+                engine_t::parameters{
+                    .digest_length = hash_byte_count,
+                    .key_length = parameters.key.size(),
+                    .salt = parameters.salt,
+                    .personal = parameters.personal },
+                parameters.key };
+        }
+
+        static auto validate_parameters(sph::blake2s_parameters parameters) -> void
+        {
+            if (parameters.key.size() > engine_t::max_key_size)
+            {
+                throw std::invalid_argument(
+                    std::format("BLAKE2s key length must be between 0 and {} bytes, got {}.",
+                        engine_t::max_key_size,
+                        parameters.key.size()));
+            }
+
+            if (!parameters.salt.empty() && parameters.salt.size() != salt_size)
+            {
+                throw std::invalid_argument(
+                    std::format("BLAKE2s salt length must be 0 or {} bytes, got {}.",
+                        salt_size,
+                        parameters.salt.size()));
+            }
+
+            if (!parameters.personal.empty() && parameters.personal.size() != personal_size)
+            {
+                throw std::invalid_argument(
+                    std::format("BLAKE2s personalization length must be 0 or {} bytes, got {}.",
+                        personal_size,
+                        parameters.personal.size()));
+            }
+        }
+    };
+}
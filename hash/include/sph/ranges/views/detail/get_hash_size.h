@@ -2,22 +2,30 @@
 #include <cstddef>
 #include <format>
 #include <stdexcept>
+#include <sph/hash_format.h>
 #include <sph/hash_param.h>
+#include <sph/hash_site.h>
 namespace sph::ranges::views::detail
 {
     /**
      * Gets the hash size from the given hash size. Verifies the requested hash
      * size is not too large and converts a zero hash size to the algorithm's
      * maximum hash size.
+     *
+     * Extendable-output algorithms have no maximum when the hash is raw and
+     * separate from the input; a zero hash size gives their default size.
      * 
      * @tparam A The hash algorithm used to create the hashed view.
+     * @tparam F The hash format (padded or raw).
+     * @tparam S The hash site (append or separate).
      * @param hash_size The proposed target hash size; zero to use the maximum target hash size.
      * @return The target hash size.
      */
-    template<sph::hash_algorithm A>
+    template<sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
     auto static constexpr get_hash_size(size_t hash_size) -> size_t
     {
-        if (hash_size > sph::hash_param<A>::hash_byte_count())
+        constexpr bool uncapped{ sph::hash_param<A>::extendable_output() && F == sph::hash_format::raw && S == sph::hash_site::separate };
+        if (!uncapped && hash_size > sph::hash_param<A>::hash_byte_count())
         {
             throw std::invalid_argument(std::format("Hash size {} is larger than maximum hash size {}", hash_size, sph::hash_param<A>::hash_byte_count()));
         }
@@ -0,0 +1,117 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <sodium/crypto_hash_sha256.h>
+#include <sph/git_object_parameters.h>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/ranges/views/detail/sha1.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * libsodium's SHA-256 behind the same interface as sha1_engine.
+     */
+    class sha256_engine
+    {
+    public:
+        static constexpr size_t digest_size{ crypto_hash_sha256_BYTES };
+    private:
+        crypto_hash_sha256_state state_;
+    public:
+        sha256_engine()
+        {
+            crypto_hash_sha256_init(&state_);
+        }
+
+        auto update(std::span<uint8_t const> data) -> void
+        {
+            if (!data.empty())
+            {
+                crypto_hash_sha256_update(&state_, data.data(), data.size());
+            }
+        }
+
+        auto final(std::span<uint8_t, digest_size> out) -> void
+        {
+            crypto_hash_sha256_final(&state_, out.data());
+        }
+    };
+
+    /**
+     * A git object id: SHA-1 or SHA-256, as git's object formats use, over
+     * the header "<type> <size>\0" followed by the content.
+     *
+     * The header needs the content size up front, so the hash_iterator
+     * measures the input range and passes it to the constructor.
+     *
+     * @tparam A hash_algorithm::git_sha1 or hash_algorithm::git_sha256.
+     */
+    template<sph::hash_algorithm A>
+        requires (A == sph::hash_algorithm::git_sha1 || A == sph::hash_algorithm::git_sha256)
+    class git_object
+    {
+        using engine_t = std::conditional_t<A == sph::hash_algorithm::git_sha1, sha1_engine, sha256_engine>;
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<A>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<A>::chunk_size() };
+    private:
+        size_t hash_size_;
+        engine_t engine_;
+        std::array<uint8_t, hash_size> hash_{};
+    public:
+        /**
+         * @param hash_byte_count the hash size.
+         * @param parameters the object type.
+         * @param object_size the number of content bytes that will be hashed.
+         */
+        git_object(size_t hash_byte_count, sph::git_object_parameters parameters = {}, uint64_t object_size = 0)
+            : hash_size_{ hash_byte_count }
+        {
+            auto const header{ std::format("{} {}", validate_type(parameters.type), object_size) };
+            engine_.update({ reinterpret_cast<uint8_t const*>(header.data()), header.size() + 1 });
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return { hash_.data(), hash_size_ };
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            engine_.update(data);
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            engine_.update(data);
+            engine_.final(hash_);
+        }
+
+    private:
+        static auto validate_type(std::string_view type) -> std::string_view
+        {
+            if (type != "blob" && type != "tree" && type != "commit" && type != "tag")
+            {
+                throw std::invalid_argument(std::format("{} object type must be blob, tree, commit, or tag, got \"{}\".", sph::hash_param<A>::name(), type));
+            }
+
+            return type;
+        }
+    };
+
+    using git_sha1 = git_object<sph::hash_algorithm::git_sha1>;
+    using git_sha256 = git_object<sph::hash_algorithm::git_sha256>;
+}
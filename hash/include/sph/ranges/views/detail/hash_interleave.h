@@ -0,0 +1,572 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_format.h>
+#include <sph/hash_param.h>
+#include <sph/hash_site.h>
+#include <sph/hasher.h>
+#include <sph/interleave_parameters.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/get_hash_size.h>
+#include <sph/ranges/views/detail/hash_util.h>
+#include <sph/ranges/views/detail/text_encoding.h>
+#include <sph/ranges/views/detail/verify_util.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * The size of a block's hash in an interleaved stream of T: raw, its
+     * text encoding, or padded out to the next whole T.
+     */
+    template<sph::hash_format F, typename T>
+    constexpr auto interleaved_hash_size(size_t hash_size) -> size_t
+    {
+        if constexpr (F == sph::hash_format::padded)
+        {
+            return (hash_size + 1 + sizeof(T) - 1) / sizeof(T) * sizeof(T);
+        }
+        else
+        {
+            return encoded_size<F>(hash_size);
+        }
+    }
+
+    /**
+     * Check the block size and hash size of an interleaved stream of T fit
+     * it: every block but the last, and every hash, is whole elements.
+     */
+    template<sph::hash_format F, typename T>
+    auto check_interleave_layout(sph::interleave_parameters const& parameters, size_t hash_size) -> void
+    {
+        if (parameters.block_size == 0 || parameters.block_size % sizeof(T) != 0)
+        {
+            throw std::invalid_argument(std::format("Interleaved block size {} isn't a whole number of {}-byte elements.", parameters.block_size, sizeof(T)));
+        }
+
+        if (auto const size{ interleaved_hash_size<F, T>(hash_size) }; size % sizeof(T) != 0)
+        {
+            throw std::invalid_argument(std::format("Interleaved hash of {} bytes isn't a whole number of {}-byte elements.", size, sizeof(T)));
+        }
+    }
+
+    /**
+     * Hashes the blocks of an interleaved stream in order, chaining each
+     * hash into the next if asked.
+     */
+    template<sph::hash_algorithm A>
+    class interleave_hasher
+    {
+        static_assert(!sph::hash_param<A>::git_object(), "A git object hash can't hash interleaved blocks.");
+        static_assert(A != sph::hash_algorithm::poly1305, "A Poly1305 key is one-time, so it can't authenticate every block.");
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+        size_t hash_size_;
+        bool chained_;
+        algorithm_parameters_t algorithm_parameters_;
+        std::vector<uint8_t> previous_{};
+    public:
+        interleave_hasher(size_t hash_size, bool chained, algorithm_parameters_t algorithm_parameters)
+            : hash_size_{ hash_size }
+            , chained_{ chained }
+            , algorithm_parameters_{ algorithm_parameters }
+        {
+        }
+
+        /**
+         * Hash the next block.
+         * @return its digest.
+         */
+        auto next(std::span<uint8_t const> block) -> std::vector<uint8_t>
+        {
+            auto hasher{ [this]()
+                {
+                    if constexpr (has_algorithm_parameters<A>)
+                    {
+                        return sph::hasher<A>{ hash_size_, algorithm_parameters_ };
+                    }
+                    else
+                    {
+                        return sph::hasher<A>{ hash_size_ };
+                    }
+                }() };
+            hasher.update(previous_);
+            hasher.update(block);
+            auto digest{ hasher.finalize() };
+            if (chained_)
+            {
+                previous_ = digest;
+            }
+
+            return digest;
+        }
+    };
+
+    /**
+     * The iterator of a hash_interleave_view: hands out the input with a
+     * hash after every block of it.
+     *
+     * A block of input is read, hashed in one update, and handed out
+     * followed by its hash, so one block is all that is held.
+     *
+     * Only one iterator can read the input, so it is move-only.
+     *
+     * @tparam R The view of the input.
+     * @tparam T The output type.
+     * @tparam A The hash algorithm.
+     * @tparam F The format of the block hashes (padded, raw, or text).
+     */
+    template<hash_range R, hashable_type T, sph::hash_algorithm A, sph::hash_format F>
+    class hash_interleave_iterator  // NOLINT(clang-diagnostic-padded)
+    {
+        using base_range_t = std::add_const_t<std::remove_reference_t<R>>;
+        using const_hashed_iterator_t = std::ranges::iterator_t<base_range_t>;
+        using const_hashed_sentinel_t = std::ranges::sentinel_t<base_range_t>;
+        using input_type = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cvref_t<T>;
+    private:
+        struct state
+        {
+            interleave_hasher<A> hasher;
+            // the current block followed by its hash
+            std::vector<uint8_t> segment{};
+        };
+        std::unique_ptr<state> state_;
+        const_hashed_iterator_t to_hash_current_;
+        const_hashed_sentinel_t to_hash_end_;
+        size_t block_size_;
+        size_t segment_position_{ 0 };
+        std::array<uint8_t, sizeof(input_type)> input_{};
+        size_t input_position_{ sizeof(input_type) };
+        value_type value_{};
+        bool last_block_{ false };
+        bool complete_{ false };
+    public:
+        /**
+         * @param begin The start of the input.
+         * @param end The end of the input.
+         * @param hash_size The size of each block's hash, before any padding
+         * or encoding.
+         * @param interleave The block size and whether the hashes chain.
+         * @param algorithm_parameters The algorithm parameters, if any.
+         */
+        hash_interleave_iterator(const_hashed_iterator_t begin, const_hashed_sentinel_t end, size_t hash_size, sph::interleave_parameters interleave, algorithm_parameters_t algorithm_parameters)
+            : state_{ std::make_unique<state>(interleave_hasher<A>{ hash_size, interleave.chained, algorithm_parameters }) }
+            , to_hash_current_{ std::move(begin) }
+            , to_hash_end_{ std::move(end) }
+            , block_size_{ interleave.block_size }
+        {
+            state_->segment.reserve(block_size_ + interleaved_hash_size<F, T>(hash_size));
+            next_value();
+        }
+
+        hash_interleave_iterator(hash_interleave_iterator&&) noexcept = default;
+        hash_interleave_iterator(hash_interleave_iterator const&) = delete;
+        ~hash_interleave_iterator() = default;
+        auto operator=(hash_interleave_iterator&&) noexcept -> hash_interleave_iterator& = default;
+        auto operator=(hash_interleave_iterator const&) -> hash_interleave_iterator& = delete;
+
+        auto operator*() const -> value_type
+        {
+            assert(!complete_ && "Cannot dereference end of hash_interleave iterator.");
+            return value_;
+        }
+
+        auto operator++() -> hash_interleave_iterator&
+        {
+            if (complete_)
+            {
+                throw std::runtime_error("Attempt to increment past end of hash.");
+            }
+
+            next_value();
+            return *this;
+        }
+
+        auto operator++(int) -> void
+        {
+            ++*this;
+        }
+
+        auto operator==(std::default_sentinel_t) const noexcept -> bool
+        {
+            return complete_;
+        }
+
+    private:
+        auto next_value() -> void
+        {
+            auto& segment{ state_->segment };
+            if (segment_position_ == segment.size())
+            {
+                if (last_block_)
+                {
+                    complete_ = true;
+                    return;
+                }
+
+                read_block();
+            }
+
+            if (auto const remaining{ segment.size() - segment_position_ }; remaining < sizeof(value_type))
+            {
+                throw std::runtime_error(std::format("Cannot handle output type size of {} bytes. The last block and its hash end {} bytes into an output value.", sizeof(value_type), remaining));
+            }
+
+            std::memcpy(&value_, segment.data() + segment_position_, sizeof(value_type));
+            segment_position_ += sizeof(value_type);
+        }
+
+        /**
+         * Read the next block of input, up to the block size, and follow it
+         * with its hash. A short block is the last one.
+         */
+        auto read_block() -> void
+        {
+            auto& segment{ state_->segment };
+            segment.clear();
+            segment_position_ = 0;
+            while (segment.size() < block_size_)
+            {
+                if (input_position_ == sizeof(input_type))
+                {
+                    if (to_hash_current_ == to_hash_end_)
+                    {
+                        last_block_ = true;
+                        break;
+                    }
+
+                    input_type const element{ *to_hash_current_ };
+                    ++to_hash_current_;
+                    std::memcpy(input_.data(), &element, sizeof(input_type));
+                    input_position_ = 0;
+                }
+
+                auto const take{ std::min(sizeof(input_type) - input_position_, block_size_ - segment.size()) };
+                segment.insert(segment.end(), input_.begin() + static_cast<ptrdiff_t>(input_position_), input_.begin() + static_cast<ptrdiff_t>(input_position_ + take));
+                input_position_ += take;
+            }
+
+            auto const digest{ state_->hasher.next(segment) };
+            auto const block_end{ segment.size() };
+            segment.resize(block_end + interleaved_hash_size<F, T>(digest.size()));
+            if constexpr (is_text_format(F))
+            {
+                encode_text<F>(digest, segment.data() + block_end);
+            }
+            else
+            {
+                std::ranges::copy(digest, segment.begin() + static_cast<ptrdiff_t>(block_end));
+                if constexpr (F == sph::hash_format::padded)
+                {
+                    segment[block_end + digest.size()] = 0x80;
+                }
+            }
+        }
+    };
+
+    /**
+     * A view of the input with a hash after every block of it.
+     *
+     * @tparam R The view of the input.
+     * @tparam T The output type.
+     * @tparam A The hash algorithm.
+     * @tparam F The format of the block hashes (padded, raw, or text).
+     */
+    template<hash_range R, hashable_type T, sph::hash_algorithm A, sph::hash_format F>
+        requires std::ranges::view<R>
+    class hash_interleave_view : public std::ranges::view_interface<hash_interleave_view<R, T, A, F>>
+    {
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+        R input_;
+        size_t target_hash_size_{};
+        sph::interleave_parameters interleave_{};
+        algorithm_parameters_t algorithm_parameters_{};
+    public:
+        using iterator = hash_interleave_iterator<R, T, A, F>;
+
+        hash_interleave_view() = default;
+
+        /**
+         * @param target_hash_size the size of each block's hash, before any
+         * padding or encoding; zero for the algorithm's default.
+         * @param input the range to hash.
+         * @param interleave the block size and whether the hashes chain.
+         * Throws std::invalid_argument if the blocks or hashes aren't whole
+         * output elements.
+         * @param algorithm_parameters the algorithm parameters, if any.
+         */
+        hash_interleave_view(size_t target_hash_size, R input, sph::interleave_parameters interleave, algorithm_parameters_t algorithm_parameters)
+            : input_{ std::move(input) }
+            , target_hash_size_{ get_hash_size<A, F, sph::hash_site::interleave>(target_hash_size) }
+            , interleave_{ interleave }
+            , algorithm_parameters_{ algorithm_parameters }
+        {
+            check_interleave_layout<F, T>(interleave_, target_hash_size_);
+        }
+
+        auto begin() const -> iterator
+        {
+            return { std::ranges::begin(input_), std::ranges::end(input_), target_hash_size_, interleave_, algorithm_parameters_ };
+        }
+
+        // ReSharper disable once CppMemberFunctionMayBeStatic
+        auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+    };
+
+    /**
+     * The iterator of a hash_verify_interleave_view: hands out the payload
+     * of an interleaved stream a block at a time, each block only after its
+     * hash is checked.
+     *
+     * Only one iterator can read the input, so it is move-only.
+     *
+     * @tparam R The view of the interleaved stream.
+     * @tparam A The hash algorithm.
+     * @tparam F The format of the block hashes (padded, raw, or text).
+     */
+    template<hash_range R, sph::hash_algorithm A, sph::hash_format F>
+    class hash_verify_interleave_iterator  // NOLINT(clang-diagnostic-padded)
+    {
+        using base_range_t = std::add_const_t<std::remove_reference_t<R>>;
+        using const_hashed_iterator_t = std::ranges::iterator_t<base_range_t>;
+        using const_hashed_sentinel_t = std::ranges::sentinel_t<base_range_t>;
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+    private:
+        struct state
+        {
+            interleave_hasher<A> hasher;
+            // the current block followed by its hash
+            std::vector<uint8_t> segment{};
+        };
+        std::unique_ptr<state> state_;
+        const_hashed_iterator_t to_hash_current_;
+        const_hashed_sentinel_t to_hash_end_;
+        size_t block_size_;
+        size_t attached_size_;
+        bool* verified_;
+        size_t block_count_{ 0 };
+        size_t block_end_{ 0 };
+        size_t segment_position_{ 0 };
+        value_type value_{};
+        bool last_block_{ false };
+        bool complete_{ false };
+    public:
+        /**
+         * @param begin The start of the interleaved stream.
+         * @param end The end of the input.
+         * @param hash_size The size of each block's hash, before any padding
+         * or encoding.
+         * @param interleave The block size and whether the hashes chain.
+         * @param verified Where to write the verification result, if
+         * anywhere; false until the end of the input. If null, a block that
+         * doesn't match its hash throws std::runtime_error instead.
+         * @param algorithm_parameters The algorithm parameters, if any.
+         */
+        hash_verify_interleave_iterator(const_hashed_iterator_t begin, const_hashed_sentinel_t end, size_t hash_size, sph::interleave_parameters interleave, bool* verified, algorithm_parameters_t algorithm_parameters)
+            : state_{ std::make_unique<state>(interleave_hasher<A>{ hash_size, interleave.chained, algorithm_parameters }) }
+            , to_hash_current_{ std::move(begin) }
+            , to_hash_end_{ std::move(end) }
+            , block_size_{ interleave.block_size }
+            , attached_size_{ interleaved_hash_size<F, value_type>(hash_size) }
+            , verified_{ verified }
+        {
+            if (verified_ != nullptr)
+            {
+                *verified_ = false;
+            }
+
+            state_->segment.reserve(block_size_ + attached_size_);
+            next_value();
+        }
+
+        hash_verify_interleave_iterator(hash_verify_interleave_iterator&&) noexcept = default;
+        hash_verify_interleave_iterator(hash_verify_interleave_iterator const&) = delete;
+        ~hash_verify_interleave_iterator() = default;
+        auto operator=(hash_verify_interleave_iterator&&) noexcept -> hash_verify_interleave_iterator& = default;
+        auto operator=(hash_verify_interleave_iterator const&) -> hash_verify_interleave_iterator& = delete;
+
+        auto operator*() const -> value_type
+        {
+            assert(!complete_ && "Cannot dereference end of hash_verify_payload iterator.");
+            return value_;
+        }
+
+        auto operator++() -> hash_verify_interleave_iterator&
+        {
+            if (complete_)
+            {
+                throw std::runtime_error("Attempt to increment past end of payload.");
+            }
+
+            next_value();
+            return *this;
+        }
+
+        auto operator++(int) -> void
+        {
+            ++*this;
+        }
+
+        auto operator==(std::default_sentinel_t) const noexcept -> bool
+        {
+            return complete_;
+        }
+
+    private:
+        auto next_value() -> void
+        {
+            while (segment_position_ == block_end_)
+            {
+                if (last_block_)
+                {
+                    complete_ = true;
+                    if (verified_ != nullptr)
+                    {
+                        *verified_ = true;
+                    }
+
+                    return;
+                }
+
+                if (!read_block())
+                {
+                    return;
+                }
+            }
+
+            std::memcpy(&value_, state_->segment.data() + segment_position_, sizeof(value_type));
+            segment_position_ += sizeof(value_type);
+        }
+
+        /**
+         * Read the next block and its hash and check them. A full block is
+         * followed by another one; a short one is the last.
+         * @return false if the block doesn't match its hash or the stream
+         * ends early and a verification result is wanted; that throws
+         * std::runtime_error otherwise.
+         */
+        auto read_block() -> bool
+        {
+            auto& segment{ state_->segment };
+            segment.clear();
+            segment_position_ = 0;
+            block_end_ = 0;
+            while (segment.size() < block_size_ + attached_size_ && to_hash_current_ != to_hash_end_)
+            {
+                value_type const element{ *to_hash_current_ };
+                ++to_hash_current_;
+                std::array<uint8_t, sizeof(value_type)> bytes{};
+                std::memcpy(bytes.data(), &element, sizeof(value_type));
+                segment.insert(segment.end(), bytes.begin(), bytes.end());
+            }
+
+            ++block_count_;
+            last_block_ = segment.size() < block_size_ + attached_size_;
+            if (segment.size() < attached_size_)
+            {
+                return fail(std::format("The interleaved {} stream is truncated in block {}.", sph::hash_param<A>::name(), block_count_));
+            }
+
+            auto const block_end{ segment.size() - attached_size_ };
+            auto const digest{ state_->hasher.next(std::span<uint8_t const>{ segment.data(), block_end }) };
+            auto const attached{ to_hash_bytes<F>(std::vector<uint8_t>(segment.begin() + static_cast<ptrdiff_t>(block_end), segment.end())) };
+            if (!attached.valid_padding
+                || attached.target_hash_size != digest.size()
+                || !digests_equal(attached.bytes, digest, digest.size()))
+            {
+                return fail(std::format("Block {} of the interleaved {} stream doesn't match its hash.", block_count_, sph::hash_param<A>::name()));
+            }
+
+            block_end_ = block_end;
+            return true;
+        }
+
+        auto fail(std::string const& message) -> bool
+        {
+            complete_ = true;
+            if (verified_ == nullptr)
+            {
+                throw std::runtime_error(message);
+            }
+
+            return false;
+        }
+    };
+
+    /**
+     * A view of the payload of an interleaved stream, as
+     * <code>sph::views::hash<A, sph::hash_site::interleave>()</code> writes
+     * it, with each block checked against its hash before it is handed out.
+     *
+     * @tparam R The view of the interleaved stream.
+     * @tparam A The hash algorithm.
+     * @tparam F The format of the block hashes (padded, raw, or text).
+     */
+    template<hash_range R, sph::hash_algorithm A, sph::hash_format F>
+        requires std::ranges::view<R>
+    class hash_verify_interleave_view : public std::ranges::view_interface<hash_verify_interleave_view<R, A, F>>
+    {
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+        using value_type = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+        R input_;
+        size_t target_hash_size_{};
+        sph::interleave_parameters interleave_{};
+        algorithm_parameters_t algorithm_parameters_{};
+        bool* verified_{};
+    public:
+        using iterator = hash_verify_interleave_iterator<R, A, F>;
+
+        hash_verify_interleave_view() = default;
+
+        /**
+         * @param target_hash_size the size of each block's hash, before any
+         * padding or encoding; zero for the algorithm's default.
+         * @param input the interleaved stream.
+         * @param interleave the block size and whether the hashes chain, as
+         * the stream was written with. Throws std::invalid_argument if the
+         * blocks or hashes aren't whole input elements.
+         * @param algorithm_parameters the algorithm parameters, if any.
+         * @param verified where to write the verification result; null to
+         * throw on a mismatch instead.
+         */
+        hash_verify_interleave_view(size_t target_hash_size, R input, sph::interleave_parameters interleave, algorithm_parameters_t algorithm_parameters, bool* verified)
+            : input_{ std::move(input) }
+            , target_hash_size_{ get_hash_size<A, F, sph::hash_site::interleave>(target_hash_size) }
+            , interleave_{ interleave }
+            , algorithm_parameters_{ algorithm_parameters }
+            , verified_{ verified }
+        {
+            check_interleave_layout<F, value_type>(interleave_, target_hash_size_);
+        }
+
+        auto begin() const -> iterator
+        {
+            return { std::ranges::begin(input_), std::ranges::end(input_), target_hash_size_, interleave_, verified_, algorithm_parameters_ };
+        }
+
+        // ReSharper disable once CppMemberFunctionMayBeStatic
+        auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+    };
+}
@@ -1,25 +1,25 @@
 #pragma once
+#include <array>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
 #include <vector>
-#include <sph/blake2b_parameters.h>
 #include <sph/hash_algorithm.h>
 #include <sph/hash_format.h>
 #include <sph/hash_site.h>
-#include <sph/ranges/views/detail/blake3.h>
-#include <sph/ranges/views/detail/blake2b.h>
+#include <sph/ranges/views/detail/algorithm_hash.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
 #include <sph/ranges/views/detail/get_hash_size.h>
 #include <sph/ranges/views/detail/hash_processor.h>
-#include <sph/ranges/views/detail/sha3_256.h>
-#include <sph/ranges/views/detail/sha3_512.h>
-#include <sph/ranges/views/detail/sha256.h>
-#include <sph/ranges/views/detail/sha512.h>
 #include <sph/ranges/views/detail/rolling_buffer.h>
 #include <sodium/crypto_generichash_blake2b.h>
 
@@ -34,16 +34,16 @@ namespace sph::ranges::views::detail
     struct hash_iterator_empty {};
 
     // Primary template: fallback
-    template <hashable_type T, sph::hash_algorithm A, bool UseRolling>
+    template <hashable_type T, sph::hash_algorithm A, sph::hash_format F, bool UseRolling>
     struct select_rolling_buffer_type;
 
-    template <hashable_type T, sph::hash_algorithm A>
-    struct select_rolling_buffer_type<T, A, true> {
-        using type = rolling_buffer<T, A>;
+    template <hashable_type T, sph::hash_algorithm A, sph::hash_format F>
+    struct select_rolling_buffer_type<T, A, F, true> {
+        using type = rolling_buffer<T, A, F>;
     };
 
-    template <hashable_type T, sph::hash_algorithm A>
-    struct select_rolling_buffer_type<T, A, false> {
+    template <hashable_type T, sph::hash_algorithm A, sph::hash_format F>
+    struct select_rolling_buffer_type<T, A, F, false> {
         using type = hash_iterator_empty;
     };
 
@@ -62,7 +62,7 @@ namespace sph::ranges::views::detail
      * @tparam R The type of the range that holds a hashed stream.
      * @tparam T The output type.
      * @tparam A The hash algorithm to use.
-     * @tparam S The hash style to use (append to hashed data or separate from hashed data). If sizeof(T) == 1, padded hashes are not acceptable.
+     * @tparam S The hash style to use (append to hashed data, prepend to it, or separate from hashed data). If sizeof(T) == 1, padded hashes are not acceptable.
      * @tparam E The iterate style to use (skip appended hash or no appended hash).
      */
     template<hash_range R, hashable_type T, sph::hash_algorithm A, sph::hash_format F, sph::hash_site S, end_of_input E>
@@ -85,20 +85,37 @@ namespace sph::ranges::views::detail
         using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
         struct input_value_with_position { input_type value; size_t position; };
         using input_value_t = std::conditional_t < sizeof(input_type) == 1, hash_iterator_empty, input_value_with_position>;
-        using hash_processor_t = hash_processor<T, S, F,
-            std::conditional_t<A == sph::hash_algorithm::blake2b, detail::blake2b,
-            std::conditional_t<A == sph::hash_algorithm::sha512, detail::sha512,
-            std::conditional_t<A == sph::hash_algorithm::sha256, detail::sha256,
-            std::conditional_t<A == sph::hash_algorithm::sha3_256, detail::sha3_256,
-            std::conditional_t<A == sph::hash_algorithm::sha3_512, detail::sha3_512,
-            std::conditional_t<A == sph::hash_algorithm::blake3, detail::blake3, void>>>>>>>;
-        using rolling_buffer_t = typename select_rolling_buffer_type<T, A, E == end_of_input::skip_appended_hash>::type;
+        using hash_processor_t = hash_processor<T, S, F, algorithm_hash_t<A>>;
+        using rolling_buffer_t = typename select_rolling_buffer_type<T, A, F, E == end_of_input::skip_appended_hash>::type;
+
+        // A prepended hash is output before the input, so the input is read
+        // twice: once to hash it, then again from here to output it.
+        static constexpr bool replay{ S == sph::hash_site::prepend };
+        static_assert(!replay || std::forward_iterator<const_hashed_iterator_t>, "A prepended hash reads the input twice, so the input must be a forward range.");
+        using replay_t = std::conditional_t<replay, const_hashed_iterator_t, hash_iterator_empty>;
+
+        // A separate or prepended hash over contiguous memory can hand the
+        // whole input to the hash at once instead of staging it a byte at a
+        // time.
+        static constexpr bool contiguous_input{
+            S != sph::hash_site::append
+            && E == end_of_input::no_appended_hash
+            && std::contiguous_iterator<const_hashed_iterator_t>
+            && std::sized_sentinel_for<const_hashed_sentinel_t, const_hashed_iterator_t> };
+
+        // Likewise, contiguous hex or base64 text from sph::views::decode
+        // gets decoded a chunk at a time straight into the hash's staging.
+        static constexpr bool contiguous_decoded_input{
+            S != sph::hash_site::append
+            && E == end_of_input::no_appended_hash
+            && contiguous_encoded_iterator<const_hashed_iterator_t> };
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunknown-attributes"
 #endif
         [[no_unique_address]] input_value_t input_{input_init()};
         [[no_unique_address]] rolling_buffer_t rolling_buffer_;
+        [[no_unique_address]] replay_t replay_;
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
@@ -108,6 +125,7 @@ namespace sph::ranges::views::detail
         T value_;
         mutable bool hash_read_complete_;
         mutable bool complete_{ false };
+        bool replaying_{ false };
     public:
         /**
          * Initialize a new instance of the hash_iterator class.
@@ -118,28 +136,33 @@ namespace sph::ranges::views::detail
          * and the hash style doesn't include padding, the hash may not be
          * storable and an exception will be thrown when that point in the
          * output range is reached.
+         * @param digest_sink Where to copy the digest, if anywhere, when the
+         * hash is finalized.
          */
-        hash_iterator(const_hashed_iterator_t begin, const_hashed_sentinel_t end, size_t hash_byte_count)
-            : hash_{ std::make_unique<hash_processor_t>(get_hash_size<A>(hash_byte_count)) }
+        hash_iterator(const_hashed_iterator_t begin, const_hashed_sentinel_t end, size_t hash_byte_count, std::span<uint8_t> digest_sink = {})
+            : replay_{ replay_init(begin) }
+            , hash_{ make_hash_processor(begin, end, hash_byte_count, digest_sink) }
             , to_hash_current_(std::move(begin))
             , to_hash_end_(std::move(end))
-            , value_{ hash_->template process<T>([this]() -> std::tuple<bool, uint8_t> { return next_byte(); }) }
+            , value_{ first_value() }
             , hash_read_complete_{ hash_->complete() }
         {
         }
 
-        hash_iterator(const_hashed_iterator_t begin, const_hashed_sentinel_t end, size_t hash_byte_count, algorithm_parameters_t parameters)
-            requires (A == sph::hash_algorithm::blake2b)
-            : hash_{ std::make_unique<hash_processor_t>(get_hash_size<A>(hash_byte_count), parameters) }
+        hash_iterator(const_hashed_iterator_t begin, const_hashed_sentinel_t end, size_t hash_byte_count, algorithm_parameters_t parameters, std::span<uint8_t> digest_sink = {})
+            requires has_algorithm_parameters<A>
+            : replay_{ replay_init(begin) }
+            , hash_{ make_hash_processor(begin, end, hash_byte_count, digest_sink, parameters) }
             , to_hash_current_(std::move(begin))
             , to_hash_end_(std::move(end))
-            , value_{ hash_->template process<T>([this]() -> std::tuple<bool, uint8_t> { return next_byte(); }) }
+            , value_{ first_value() }
             , hash_read_complete_{ hash_->complete() }
         {
         }
 
         hash_iterator(hash_iterator<R, T, A, F, S, E>& o) noexcept
-            : hash_{ nullptr } // only one can hash at a time
+            : replay_{ o.replay_ }
+            , hash_{ nullptr } // only one can hash at a time
             , to_hash_current_{o.to_hash_current_}
             , to_hash_end_{ o.to_hash_end_ }
             , value_{ o.value_ }
@@ -152,6 +175,7 @@ namespace sph::ranges::views::detail
             if (&o != this)
             {
                 hash_.reset(); // only one can hash at a time
+                replay_ = o.replay_;
                 to_hash_current_ = o.to_hash_current_;
                 to_hash_end_ = o.to_hash_end_;
                 value_ = o.value_;
@@ -196,7 +220,7 @@ namespace sph::ranges::views::detail
             }
             else
             {
-                complete_ = true;
+                next_replay_value();
             }
 
             return ret;
@@ -216,7 +240,7 @@ namespace sph::ranges::views::detail
             }
             else
             {
-                complete_ = true;
+                next_replay_value();
             }
 
             return *this;
@@ -293,6 +317,120 @@ namespace sph::ranges::views::detail
             }
         }
 
+        /**
+         * Create the hash for the input range.
+         *
+         * A git object hash starts with a header holding the input's size, so
+         * the range is measured first; that takes a forward range, and the
+         * size is unknown when the range ends in an appended hash to verify.
+         */
+        template<typename... P>
+        static auto make_hash_processor(const_hashed_iterator_t const& begin, const_hashed_sentinel_t const& end, size_t hash_byte_count, std::span<uint8_t> digest_sink, P const&... parameters) -> std::unique_ptr<hash_processor_t>
+        {
+            if constexpr (sph::hash_param<A>::git_object())
+            {
+                static_assert(std::forward_iterator<const_hashed_iterator_t>, "A git object hash needs the input size up front, so the input must be a forward range.");
+                static_assert(E == end_of_input::no_appended_hash, "A git object hash cannot verify a hash appended to its input.");
+                auto const object_size{ static_cast<uint64_t>(std::ranges::distance(begin, end)) * sizeof(input_type) };
+                auto ret{ std::make_unique<hash_processor_t>(get_hash_size<A, F, S>(hash_byte_count), algorithm_parameters_t{ parameters... }, object_size) };
+                ret->set_digest_sink(digest_sink);
+                return ret;
+            }
+            else
+            {
+                auto ret{ std::make_unique<hash_processor_t>(get_hash_size<A, F, S>(hash_byte_count), parameters...) };
+                ret->set_digest_sink(digest_sink);
+                return ret;
+            }
+        }
+
+        /**
+         * Hash the input and get the first output value.
+         *
+         * Contiguous input goes to the hash in a single call, contiguous
+         * encoded text is decoded into the hash a chunk at a time; anything
+         * else is pulled through next_byte().
+         */
+        auto first_value() -> T
+        {
+            if constexpr (contiguous_input)
+            {
+                auto const count{ static_cast<size_t>(to_hash_end_ - to_hash_current_) };
+                std::span<uint8_t const> input{};
+                if (count != 0)
+                {
+                    input = { reinterpret_cast<uint8_t const*>(std::to_address(to_hash_current_)), count * sizeof(input_type) };
+                }
+
+                to_hash_current_ = std::ranges::next(to_hash_current_, to_hash_end_);
+                return hash_->template process_all<T>(input);
+            }
+            else if constexpr (contiguous_decoded_input)
+            {
+                text_decoder<const_hashed_iterator_t::encoding> decoder{ to_hash_current_.encoded() };
+                to_hash_current_.consume();
+                return hash_->template process_decoded<T>(decoder);
+            }
+            else
+            {
+                return hash_->template process<T>([this]() -> std::tuple<bool, uint8_t> { return next_byte(); });
+            }
+        }
+
+        static auto replay_init(const_hashed_iterator_t const& begin) -> replay_t
+        {
+            if constexpr (replay)
+            {
+                return begin;
+            }
+            else
+            {
+                return {};
+            }
+        }
+
+        /**
+         * After the hash, output the input again from the start, or, for
+         * the other sites, just mark the end.
+         */
+        auto next_replay_value() -> void
+        {
+            if constexpr (replay)
+            {
+                if (!replaying_)
+                {
+                    // just output the last hash value; go back to the start
+                    replaying_ = true;
+                    to_hash_current_ = replay_;
+                    input_ = input_init();
+                }
+
+                std::array<uint8_t, sizeof(T)> bytes{};
+                for (size_t i = 0; i < bytes.size(); ++i)
+                {
+                    auto const [valid_value, value] { next_byte_from_input_range() };
+                    if (!valid_value)
+                    {
+                        if (i != 0)
+                        {
+                            throw std::runtime_error(std::format("Cannot handle output type size of {} bytes. The input ends {} bytes into an output value.", sizeof(T), i));
+                        }
+
+                        complete_ = true;
+                        return;
+                    }
+
+                    bytes[i] = value;
+                }
+
+                std::memcpy(&value_, bytes.data(), sizeof(T));
+            }
+            else
+            {
+                complete_ = true;
+            }
+        }
+
         auto verify_can_increment() const -> void
         {
             verify_can_hash();
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -12,6 +13,8 @@
 #include <sph/hash_format.h>
 #include <sph/ranges/views/detail/padded_hash.h>
 #include <sph/ranges/views/detail/process_util.h>
+#include <sph/ranges/views/detail/text_hash.h>
+#include <sph/ranges/views/detail/text_encoding.h>
 
 namespace sph::ranges::views::detail
 {
@@ -31,7 +34,7 @@ namespace sph::ranges::views::detail
      *
      * @tparam O The output type. Process returns one of these each time it is called.
      * @tparam S The hash site. Append, or separate.
-     * @tparam F The hash format. padded, or raw.
+     * @tparam F The hash format. padded, raw, or a text format.
      * @tparam H The hash. Sha256, sha512, Blake2b.
      */
     template<typename O, sph::hash_site S, sph::hash_format F, basic_hash H>
@@ -40,13 +43,19 @@ namespace sph::ranges::views::detail
         static constexpr bool return_inputs{ S == sph::hash_site::append};
         static constexpr bool single_byte{ sizeof(O) == 1 };
         static constexpr bool pad_hash{ F == sph::hash_format::padded};
-        using hash_t = std::conditional_t<pad_hash, padded_hash<O, H>, H>;
+        static constexpr bool text{ is_text_format(F) };
+        using hash_t = std::conditional_t<pad_hash, padded_hash<O, H>, std::conditional_t<text, text_hash<F, H>, H>>;
+        // Extendable output is read one block at a time; padding and text
+        // need the whole hash at once, so they stay within the first block.
+        static constexpr bool extendable{ extendable_hash<H> && !pad_hash && !text };
         using hash_begin_t = decltype(std::declval<hash_t>().hash().begin());
         using hash_end_t = decltype(std::declval<hash_t>().hash().begin());
         hash_t hash_;
         hash_begin_t hash_begin_{};
         hash_begin_t hash_current_{};
         hash_end_t hash_end_{};
+        // hash bytes in blocks before the current one (extendable output only)
+        size_t hash_offset_{};
         std::array<uint8_t, H::chunk_size> chunk_{};
         typename std::array<uint8_t, H::chunk_size>::iterator chunk_current_{ chunk_.begin() };
         struct empty {};
@@ -75,6 +84,8 @@ namespace sph::ranges::views::detail
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
+        // where to copy the digest when the hash is finalized, if anywhere
+        std::span<uint8_t> digest_sink_{};
         bool input_complete_{ false };
     public:
         template<bool SingleByte = single_byte, typename... Args>
@@ -99,11 +110,25 @@ namespace sph::ranges::views::detail
             return hash_.target_hash_size();
         }
 
+        /**
+         * Set where to copy the digest, before any padding or encoding, when
+         * the hash is finalized. Only its first digest_sink.size() bytes are
+         * copied.
+         */
+        auto set_digest_sink(std::span<uint8_t> digest_sink) -> void
+        {
+            digest_sink_ = digest_sink;
+        }
+
         auto hash_size() const -> size_t
         {
-            return static_cast<size_t>(std::distance<decltype(hash_begin_)>(hash_begin_, hash_current_));
+            return hash_offset_ + static_cast<size_t>(std::distance<decltype(hash_begin_)>(hash_begin_, hash_current_));
         }
 
+        /**
+         * Get the hash bytes read so far. For extendable output, only those
+         * from the current block.
+         */
         auto hash() const
         {
             return std::ranges::subrange(hash_begin_, hash_current_);
@@ -121,7 +146,7 @@ namespace sph::ranges::views::detail
 
         auto hash_position() const -> size_t
         {
-            return std::distance<decltype(hash_begin_)>(hash_begin_, hash_current_);
+            return hash_size();
         }
 
         template<typename T, next_byte_function N>
@@ -130,7 +155,7 @@ namespace sph::ranges::views::detail
         {
             if (input_complete_)
             {
-                return hash_current_ == hash_end_ ? 0 : *hash_current_++;
+                return hash_size() == target_hash_size() ? O{} : static_cast<O>(next_hash_byte());
             }
 
             if (auto [byte_ok, byte_value] {hash_next_byte(next_byte)}; byte_ok)
@@ -139,11 +164,8 @@ namespace sph::ranges::views::detail
             }
 
             hash_.final({ chunk_.data(), static_cast<size_t>(std::distance(chunk_.begin(), chunk_current_)) });
-            auto hash{ hash_.hash() };
-            hash_begin_ = hash_current_ = hash.begin();
-            hash_end_ = hash.end();
-            input_complete_ = true;
-            return static_cast<O>(*hash_current_++);
+            begin_hash_output();
+            return static_cast<O>(next_hash_byte());
         }
 
         template<typename T, next_byte_function N>
@@ -152,7 +174,7 @@ namespace sph::ranges::views::detail
         {
             if (input_complete_)
             {
-                return hash_size() == target_hash_size() ? 0 : *hash_current_++;
+                return hash_size() == target_hash_size() ? O{} : static_cast<O>(next_hash_byte());
             }
 
             while (true)
@@ -164,11 +186,8 @@ namespace sph::ranges::views::detail
             }
 
             hash_.final({ chunk_.data(), static_cast<size_t>(std::distance(chunk_.begin(), chunk_current_)) });
-            auto hash{ hash_.hash() };
-            hash_begin_ = hash_current_ = hash.begin();
-            hash_end_ = hash.end();
-            input_complete_ = true;
-            return static_cast<O>(*hash_current_++);
+            begin_hash_output();
+            return static_cast<O>(next_hash_byte());
         }
 
         template<typename T, next_byte_function N>
@@ -182,14 +201,14 @@ namespace sph::ranges::views::detail
                     return O{};
                 }
 
-                if (static_cast<size_t>(std::distance(hash_current_, hash_end_)) < sizeof(O))
+                if (auto const remaining{ target_hash_size() - hash_size() }; remaining < sizeof(O))
                 {
                     auto hash_size{ static_cast<size_t>(std::distance(hash_begin_, hash_end_)) };
                     throw std::runtime_error(
                         std::format(
                             "Cannot handle output type size of {} bytes. {} hash bytes remaining. Not enough hash data to fill the output value. Expected {} bytes, only {}{} hash bytes available.",
                             sizeof(O),
-                            std::distance(hash_current_, hash_end_),
+                            remaining,
                             hash_.target_hash_size(),
                             hash_.target_hash_size() < hash_size ? std::format(" of {}", hash_size) : std::format(""),
                             hash_size));
@@ -197,7 +216,7 @@ namespace sph::ranges::views::detail
 
                 while (true)
                 {
-                    *value_buf_current_++ = *hash_current_++;
+                    *value_buf_current_++ = next_hash_byte();
                     if (value_buf_current_ == value_buf_.end())
                     {
                         value_buf_current_ = value_buf_.begin();
@@ -233,14 +252,11 @@ namespace sph::ranges::views::detail
                 auto current_partial_byte_count{ static_cast<size_t>(std::distance(value_buf_.begin(), value_buf_current_)) };
                 hash_.set_target_hash_size((((current_partial_byte_count + hash_.target_hash_size() + sizeof(O) - 1) / sizeof(O)) * sizeof(O)) - current_partial_byte_count);
             }
-            auto hash{ hash_.hash() };
-            hash_begin_ = hash_current_ = hash.begin();
-            hash_end_ = hash.end();
-            input_complete_ = true;
+            begin_hash_output();
 
             while (true)
             {
-                *value_buf_current_++ = *hash_current_++;
+                *value_buf_current_++ = next_hash_byte();
                 if (value_buf_current_ == value_buf_.end())
                 {
                     value_buf_current_ = value_buf_.begin();
@@ -248,7 +264,136 @@ namespace sph::ranges::views::detail
                 }
             }
         }
+
+        /**
+         * Hash the entire input in one call and return the first output value.
+         *
+         * Skips the chunk_ staging that process() does a byte at a time; the
+         * whole input goes straight to the hash's final(). Only valid for
+         * separate hashes and only before any call to process().
+         *
+         * @param input All the bytes to hash.
+         */
+        template<typename T>
+            requires (std::is_standard_layout_v<T> && !return_inputs)
+        auto process_all(std::span<uint8_t const> input) -> T
+        {
+            return finish_all<T>(input);
+        }
+
+        /**
+         * Hash all the text a decoder reads and return the first output
+         * value.
+         *
+         * The text is decoded a chunk at a time straight into chunk_, so the
+         * decoded input never exists as a whole. Only valid for separate
+         * hashes and only before any call to process().
+         *
+         * @param decoder The decoder over all the text to hash.
+         */
+        template<typename T, sph::hash_format D>
+            requires (std::is_standard_layout_v<T> && !return_inputs)
+        auto process_decoded(text_decoder<D>& decoder) -> T
+        {
+            while (true)
+            {
+                auto const count{ decoder.read(chunk_) };
+                if (count < chunk_.size() || decoder.done())
+                {
+                    return finish_all<T>({ chunk_.data(), count });
+                }
+
+                hash_.update(chunk_);
+            }
+        }
+
         private:
+            /**
+             * Finalize the hash with the last of the input and return the
+             * first output value.
+             */
+            template<typename T>
+            auto finish_all(std::span<uint8_t const> input) -> T
+            {
+                hash_.final(input);
+                if constexpr (single_byte)
+                {
+                    begin_hash_output();
+                    return static_cast<O>(next_hash_byte());
+                }
+                else
+                {
+                    if constexpr (pad_hash)
+                    {
+                        // extend the hash pad to fill up to the next multiple of sizeof(O)
+                        hash_.set_target_hash_size(((hash_.target_hash_size() + sizeof(O) - 1) / sizeof(O)) * sizeof(O));
+                    }
+
+                    begin_hash_output();
+                    while (true)
+                    {
+                        *value_buf_current_++ = next_hash_byte();
+                        if (value_buf_current_ == value_buf_.end())
+                        {
+                            value_buf_current_ = value_buf_.begin();
+                            return value_;
+                        }
+                    }
+                }
+            }
+
+            auto begin_hash_output() -> void
+            {
+                if (!digest_sink_.empty())
+                {
+                    fill_digest_sink();
+                }
+
+                auto hash{ hash_.hash() };
+                hash_begin_ = hash_current_ = hash.begin();
+                hash_end_ = hash.end();
+                hash_offset_ = 0;
+                input_complete_ = true;
+            }
+
+            auto fill_digest_sink() -> void
+            {
+                auto const digest{ [this]()
+                    {
+                        if constexpr (pad_hash || text)
+                        {
+                            return hash_.digest();
+                        }
+                        else
+                        {
+                            return hash_.hash();
+                        }
+                    }() };
+                auto const size{ std::min(static_cast<size_t>(std::ranges::distance(digest)), digest_sink_.size()) };
+                std::ranges::copy_n(std::ranges::begin(digest), static_cast<ptrdiff_t>(size), digest_sink_.begin());
+            }
+
+            /**
+             * Read the next hash byte, moving extendable output on to its
+             * next block when the current one is used up.
+             */
+            auto next_hash_byte() -> uint8_t
+            {
+                if constexpr (extendable)
+                {
+                    if (hash_current_ == hash_end_)
+                    {
+                        hash_offset_ += static_cast<size_t>(std::distance(hash_begin_, hash_end_));
+                        hash_.next_block();
+                        auto hash{ hash_.hash() };
+                        hash_begin_ = hash_current_ = hash.begin();
+                        hash_end_ = hash.end();
+                    }
+                }
+
+                return *hash_current_++;
+            }
+
             template<next_byte_function N>
             auto hash_next_byte(N next_byte) -> std::tuple<bool, uint8_t>
             {
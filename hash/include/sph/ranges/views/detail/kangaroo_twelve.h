@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/k12_parameters.h>
+#include <sph/ranges/views/detail/keccak.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * KangarooTwelve (KT128, RFC 9861).
+     *
+     * The message, followed by the customization string and its length, is
+     * cut into 8192-byte chunks. The first chunk goes straight into the final
+     * node; every later chunk is a leaf hashed on its own with TurboSHAKE128
+     * to a 32-byte chaining value that the final node absorbs in order. Leaves
+     * are independent, so they are collected in groups and hashed together
+     * by keccak_hash_each(), four at a time in SIMD lanes when AVX2 is enabled
+     * at compile time. Inputs of at most one chunk are a single TurboSHAKE128
+     * call. The output is squeezed one block at a time, as for keccak_xof.
+     */
+    class kangaroo_twelve
+    {
+        static constexpr size_t rate{ 168 };
+        static constexpr size_t rounds{ 12 };
+        using sponge_t = keccak_sponge<rate, rounds>;
+        static constexpr size_t leaf_size{ 8192 };
+        static constexpr size_t leaf_group_size{ 4 };
+        static constexpr size_t chaining_value_size{ 32 };
+        static constexpr uint8_t single_node_domain{ 0x07 };
+        static constexpr uint8_t final_node_domain{ 0x06 };
+        static constexpr uint8_t leaf_domain{ 0x0B };
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<sph::hash_algorithm::k12>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<sph::hash_algorithm::k12>::chunk_size() };
+    private:
+        sponge_t final_node_;
+        uint64_t message_size_{};
+        uint64_t leaf_count_{};
+        // Leaf bytes not yet hashed; at most one group of leaves.
+        std::vector<uint8_t> leaves_;
+        std::vector<uint8_t> customization_;
+        keccak_output<rate> output_;
+        size_t hash_size_;
+    public:
+        explicit kangaroo_twelve(size_t hash_byte_count, sph::k12_parameters parameters = {})
+            : customization_{ parameters.customization.begin(), parameters.customization.end() }
+            , hash_size_{ hash_byte_count }
+        {
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return output_.block();
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            absorb(data);
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            absorb(data);
+            absorb(customization_);
+            absorb(length_encode(customization_.size()));
+            if (message_size_ <= leaf_size)
+            {
+                final_node_.pad(single_node_domain);
+                output_.first_block(final_node_, hash_size_);
+                return;
+            }
+
+            hash_leaves(leaves_);
+            final_node_.absorb(length_encode(leaf_count_));
+            final_node_.absorb(std::array<uint8_t, 2>{ 0xFF, 0xFF });
+            final_node_.pad(final_node_domain);
+            output_.first_block(final_node_, hash_size_);
+        }
+
+        auto next_block() -> void
+        {
+            output_.next_block(final_node_);
+        }
+
+    private:
+        /**
+         * Encode a length as its big-endian bytes, without leading zeros,
+         * followed by the number of those bytes.
+         */
+        static auto length_encode(uint64_t value) -> std::vector<uint8_t>
+        {
+            std::vector<uint8_t> encoded;
+            for (; value != 0; value >>= 8)
+            {
+                encoded.insert(encoded.begin(), static_cast<uint8_t>(value));
+            }
+
+            encoded.push_back(static_cast<uint8_t>(encoded.size()));
+            return encoded;
+        }
+
+        auto absorb(std::span<uint8_t const> data) -> void
+        {
+            while (!data.empty())
+            {
+                if (message_size_ < leaf_size)
+                {
+                    auto const take{ static_cast<size_t>(std::min<uint64_t>(leaf_size - message_size_, data.size())) };
+                    final_node_.absorb(data.first(take));
+                    message_size_ += take;
+                    data = data.subspan(take);
+                    continue;
+                }
+
+                if (message_size_ == leaf_size)
+                {
+                    // the input outgrew one chunk: the final node becomes a tree root
+                    final_node_.absorb(std::array<uint8_t, 8>{ 0x03 });
+                }
+
+                constexpr size_t group_bytes{ leaf_group_size * leaf_size };
+                if (leaves_.empty() && data.size() >= group_bytes)
+                {
+                    // hash whole groups in place; the tail is buffered below
+                    auto const direct{ data.size() - (data.size() % group_bytes) };
+                    hash_leaves(data.first(direct));
+                    message_size_ += direct;
+                    data = data.subspan(direct);
+                    continue;
+                }
+
+                auto const take{ std::min(group_bytes - leaves_.size(), data.size()) };
+                leaves_.insert(leaves_.end(), data.begin(), data.begin() + static_cast<ptrdiff_t>(take));
+                message_size_ += take;
+                data = data.subspan(take);
+                if (leaves_.size() == group_bytes)
+                {
+                    hash_leaves(leaves_);
+                    leaves_.clear();
+                }
+            }
+        }
+
+        /**
+         * Hash leaves into chaining values and absorb them into the final
+         * node. Only the last leaf may be short.
+         */
+        auto hash_leaves(std::span<uint8_t const> leaves) -> void
+        {
+            auto const full_leaves{ leaves.size() / leaf_size };
+            std::array<uint8_t, leaf_group_size * chaining_value_size> chaining_values{};
+            for (size_t first = 0; first < full_leaves; first += leaf_group_size)
+            {
+                auto const count{ std::min(leaf_group_size, full_leaves - first) };
+                auto const out{ std::span<uint8_t>{ chaining_values.data(), count * chaining_value_size } };
+                keccak_hash_each<rate, rounds>(leaves.subspan(first * leaf_size, count * leaf_size), leaf_size, leaf_domain, out);
+                final_node_.absorb(out);
+            }
+
+            leaf_count_ += full_leaves;
+            if (auto const tail{ leaves.subspan(full_leaves * leaf_size) }; !tail.empty())
+            {
+                auto const out{ std::span<uint8_t>{ chaining_values.data(), chaining_value_size } };
+                keccak_hash_each<rate, rounds>(tail, tail.size(), leaf_domain, out);
+                final_node_.absorb(out);
+                ++leaf_count_;
+            }
+        }
+    };
+
+    using k12 = kangaroo_twelve;
+}
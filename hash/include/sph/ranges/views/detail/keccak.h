@@ -0,0 +1,392 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * Keccak lane operations on one 64-bit word.
+     */
+    struct keccak_scalar_ops
+    {
+        using word = uint64_t;
+        static auto xor2(word a, word b) -> word { return a ^ b; }
+        static auto xor3(word a, word b, word c) -> word { return a ^ b ^ c; }
+        static auto andnot(word a, word b) -> word { return ~a & b; }
+        static auto constant(uint64_t x) -> word { return x; }
+        template<int N>
+        static auto rotl(word x) -> word { return std::rotl(x, N); }
+    };
+
+#if defined(__AVX2__)
+    /**
+     * Keccak lane operations on the same lane of four states at once, one
+     * state per 64-bit element of a 256-bit register.
+     */
+    struct keccak_avx2_ops
+    {
+        using word = __m256i;
+        static auto xor2(word a, word b) -> word { return _mm256_xor_si256(a, b); }
+        static auto xor3(word a, word b, word c) -> word { return _mm256_xor_si256(_mm256_xor_si256(a, b), c); }
+        static auto andnot(word a, word b) -> word { return _mm256_andnot_si256(a, b); }
+        static auto constant(uint64_t x) -> word { return _mm256_set1_epi64x(static_cast<long long>(x)); }
+        template<int N>
+        static auto rotl(word x) -> word { return _mm256_or_si256(_mm256_slli_epi64(x, N), _mm256_srli_epi64(x, 64 - N)); }
+    };
+#endif
+
+    /**
+     * The Keccak-p[1600] permutation shared by the Keccak-based algorithms
+     * libsodium does not provide (TurboSHAKE, KangarooTwelve).
+     *
+     * The reduced-round permutations run the last Rounds rounds of
+     * Keccak-f[1600], so Rounds = 24 is the full SHA-3 permutation and
+     * Rounds = 12 is the one TurboSHAKE and KangarooTwelve use.
+     */
+    struct keccak
+    {
+        static constexpr size_t state_words{ 25 };
+        using state = std::array<uint64_t, state_words>;
+
+        static constexpr std::array<uint64_t, 24> round_constants{
+            0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+            0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+            0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+            0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+            0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+            0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL };
+
+        /**
+         * Permute the lanes a[x + 5y] with the given lane operations.
+         *
+         * Each round is written out in full (theta, then rho and pi
+         * together into b, then chi and iota) so every lane stays in a
+         * register.
+         */
+        template<typename Ops, size_t Rounds>
+            requires (Rounds > 0 && Rounds <= 24)
+        static auto permute(typename Ops::word* a) -> void
+        {
+            for (size_t round = 24 - Rounds; round < 24; ++round)
+            {
+                auto const c0{ Ops::xor3(Ops::xor3(a[0], a[5], a[10]), a[15], a[20]) };
+                auto const c1{ Ops::xor3(Ops::xor3(a[1], a[6], a[11]), a[16], a[21]) };
+                auto const c2{ Ops::xor3(Ops::xor3(a[2], a[7], a[12]), a[17], a[22]) };
+                auto const c3{ Ops::xor3(Ops::xor3(a[3], a[8], a[13]), a[18], a[23]) };
+                auto const c4{ Ops::xor3(Ops::xor3(a[4], a[9], a[14]), a[19], a[24]) };
+                auto const d0{ Ops::xor2(c4, Ops::template rotl<1>(c1)) };
+                auto const d1{ Ops::xor2(c0, Ops::template rotl<1>(c2)) };
+                auto const d2{ Ops::xor2(c1, Ops::template rotl<1>(c3)) };
+                auto const d3{ Ops::xor2(c2, Ops::template rotl<1>(c4)) };
+                auto const d4{ Ops::xor2(c3, Ops::template rotl<1>(c0)) };
+                auto const b0{ Ops::xor2(a[0], d0) };
+                auto const b1{ Ops::template rotl<44>(Ops::xor2(a[6], d1)) };
+                auto const b2{ Ops::template rotl<43>(Ops::xor2(a[12], d2)) };
+                auto const b3{ Ops::template rotl<21>(Ops::xor2(a[18], d3)) };
+                auto const b4{ Ops::template rotl<14>(Ops::xor2(a[24], d4)) };
+                auto const b5{ Ops::template rotl<28>(Ops::xor2(a[3], d3)) };
+                auto const b6{ Ops::template rotl<20>(Ops::xor2(a[9], d4)) };
+                auto const b7{ Ops::template rotl<3>(Ops::xor2(a[10], d0)) };
+                auto const b8{ Ops::template rotl<45>(Ops::xor2(a[16], d1)) };
+                auto const b9{ Ops::template rotl<61>(Ops::xor2(a[22], d2)) };
+                auto const b10{ Ops::template rotl<1>(Ops::xor2(a[1], d1)) };
+                auto const b11{ Ops::template rotl<6>(Ops::xor2(a[7], d2)) };
+                auto const b12{ Ops::template rotl<25>(Ops::xor2(a[13], d3)) };
+                auto const b13{ Ops::template rotl<8>(Ops::xor2(a[19], d4)) };
+                auto const b14{ Ops::template rotl<18>(Ops::xor2(a[20], d0)) };
+                auto const b15{ Ops::template rotl<27>(Ops::xor2(a[4], d4)) };
+                auto const b16{ Ops::template rotl<36>(Ops::xor2(a[5], d0)) };
+                auto const b17{ Ops::template rotl<10>(Ops::xor2(a[11], d1)) };
+                auto const b18{ Ops::template rotl<15>(Ops::xor2(a[17], d2)) };
+                auto const b19{ Ops::template rotl<56>(Ops::xor2(a[23], d3)) };
+                auto const b20{ Ops::template rotl<62>(Ops::xor2(a[2], d2)) };
+                auto const b21{ Ops::template rotl<55>(Ops::xor2(a[8], d3)) };
+                auto const b22{ Ops::template rotl<39>(Ops::xor2(a[14], d4)) };
+                auto const b23{ Ops::template rotl<41>(Ops::xor2(a[15], d0)) };
+                auto const b24{ Ops::template rotl<2>(Ops::xor2(a[21], d1)) };
+                a[0] = Ops::xor2(b0, Ops::andnot(b1, b2));
+                a[1] = Ops::xor2(b1, Ops::andnot(b2, b3));
+                a[2] = Ops::xor2(b2, Ops::andnot(b3, b4));
+                a[3] = Ops::xor2(b3, Ops::andnot(b4, b0));
+                a[4] = Ops::xor2(b4, Ops::andnot(b0, b1));
+                a[5] = Ops::xor2(b5, Ops::andnot(b6, b7));
+                a[6] = Ops::xor2(b6, Ops::andnot(b7, b8));
+                a[7] = Ops::xor2(b7, Ops::andnot(b8, b9));
+                a[8] = Ops::xor2(b8, Ops::andnot(b9, b5));
+                a[9] = Ops::xor2(b9, Ops::andnot(b5, b6));
+                a[10] = Ops::xor2(b10, Ops::andnot(b11, b12));
+                a[11] = Ops::xor2(b11, Ops::andnot(b12, b13));
+                a[12] = Ops::xor2(b12, Ops::andnot(b13, b14));
+                a[13] = Ops::xor2(b13, Ops::andnot(b14, b10));
+                a[14] = Ops::xor2(b14, Ops::andnot(b10, b11));
+                a[15] = Ops::xor2(b15, Ops::andnot(b16, b17));
+                a[16] = Ops::xor2(b16, Ops::andnot(b17, b18));
+                a[17] = Ops::xor2(b17, Ops::andnot(b18, b19));
+                a[18] = Ops::xor2(b18, Ops::andnot(b19, b15));
+                a[19] = Ops::xor2(b19, Ops::andnot(b15, b16));
+                a[20] = Ops::xor2(b20, Ops::andnot(b21, b22));
+                a[21] = Ops::xor2(b21, Ops::andnot(b22, b23));
+                a[22] = Ops::xor2(b22, Ops::andnot(b23, b24));
+                a[23] = Ops::xor2(b23, Ops::andnot(b24, b20));
+                a[24] = Ops::xor2(b24, Ops::andnot(b20, b21));
+                a[0] = Ops::xor2(a[0], Ops::constant(round_constants[round]));
+            }
+        }
+
+        template<size_t Rounds>
+        static auto permute(state& a) -> void
+        {
+            permute<keccak_scalar_ops, Rounds>(a.data());
+        }
+
+        /**
+         * Load a little-endian lane.
+         */
+        static auto load(uint8_t const* bytes) -> uint64_t
+        {
+            uint64_t ret;
+            std::memcpy(&ret, bytes, sizeof(ret));
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                ret = std::byteswap(ret);
+            }
+
+            return ret;
+        }
+    };
+
+    /**
+     * A Keccak sponge with the given rate and round count.
+     *
+     * Bytes are absorbed with absorb(), the domain separation byte and final
+     * padding bit are applied by pad(), and output is read with squeeze().
+     *
+     * @tparam Rate The rate in bytes: 168 for 128-bit security, 136 for 256-bit.
+     * @tparam Rounds The number of Keccak-p rounds.
+     */
+    template<size_t Rate, size_t Rounds>
+        requires (Rate % sizeof(uint64_t) == 0 && Rate < keccak::state_words * sizeof(uint64_t))
+    class keccak_sponge
+    {
+    public:
+        static constexpr size_t rate{ Rate };
+    private:
+        keccak::state a_{};
+        size_t position_{};
+    public:
+        auto absorb(std::span<uint8_t const> data) -> void
+        {
+            while (!data.empty())
+            {
+                if (position_ == 0 && data.size() >= Rate)
+                {
+                    for (size_t i = 0; i < Rate / sizeof(uint64_t); ++i)
+                    {
+                        a_[i] ^= keccak::load(data.data() + (i * sizeof(uint64_t)));
+                    }
+
+                    keccak::permute<Rounds>(a_);
+                    data = data.subspan(Rate);
+                    continue;
+                }
+
+                auto const take{ std::min(Rate - position_, data.size()) };
+                for (size_t i = 0; i < take; ++i)
+                {
+                    xor_byte(position_ + i, data[i]);
+                }
+
+                position_ += take;
+                data = data.subspan(take);
+                if (position_ == Rate)
+                {
+                    keccak::permute<Rounds>(a_);
+                    position_ = 0;
+                }
+            }
+        }
+
+        /**
+         * Finish absorbing.
+         *
+         * @param domain the domain separation byte with its first padding
+         * bit, e.g. 0x1F for SHAKE and TurboSHAKE.
+         */
+        auto pad(uint8_t domain) -> void
+        {
+            xor_byte(position_, domain);
+            xor_byte(Rate - 1, 0x80);
+            keccak::permute<Rounds>(a_);
+            position_ = 0;
+        }
+
+        /**
+         * Read output; may only be called after pad().
+         */
+        auto squeeze(std::span<uint8_t> out) -> void
+        {
+            while (!out.empty())
+            {
+                if (position_ == Rate)
+                {
+                    keccak::permute<Rounds>(a_);
+                    position_ = 0;
+                }
+
+                auto const take{ std::min(Rate - position_, out.size()) };
+                for (size_t i = 0; i < take; ++i)
+                {
+                    out[i] = static_cast<uint8_t>(a_[(position_ + i) / sizeof(uint64_t)] >> (8 * ((position_ + i) % sizeof(uint64_t))));
+                }
+
+                position_ += take;
+                out = out.subspan(take);
+            }
+        }
+
+    private:
+        auto xor_byte(size_t position, uint8_t value) -> void
+        {
+            a_[position / sizeof(uint64_t)] ^= static_cast<uint64_t>(value) << (8 * (position % sizeof(uint64_t)));
+        }
+    };
+
+    /**
+     * Extendable output squeezed one rate block at a time, so a long output
+     * never has to be held all at once.
+     *
+     * @tparam Rate The sponge rate in bytes.
+     */
+    template<size_t Rate>
+    class keccak_output
+    {
+        std::array<uint8_t, Rate> block_{};
+        size_t block_size_{};
+        size_t remaining_{};
+    public:
+        /**
+         * Squeeze the first block of an output_size byte output from a padded
+         * sponge.
+         */
+        template<size_t Rounds>
+        auto first_block(keccak_sponge<Rate, Rounds>& sponge, size_t output_size) -> void
+        {
+            remaining_ = output_size;
+            next_block(sponge);
+        }
+
+        /**
+         * Squeeze the next block, replacing the current one; shorter than
+         * Rate only at the end of the output.
+         */
+        template<size_t Rounds>
+        auto next_block(keccak_sponge<Rate, Rounds>& sponge) -> void
+        {
+            block_size_ = std::min(Rate, remaining_);
+            sponge.squeeze(std::span<uint8_t>{ block_.data(), block_size_ });
+            remaining_ -= block_size_;
+        }
+
+        auto block() const -> std::span<uint8_t const>
+        {
+            return { block_.data(), block_size_ };
+        }
+    };
+
+    /**
+     * Hash equal-length inputs independently, as tree modes do for their
+     * leaves, splitting out evenly between them.
+     *
+     * With AVX2 enabled at compile time, four inputs at a time are absorbed
+     * with each in its own SIMD lane; the rest go through keccak_sponge.
+     *
+     * @param inputs the inputs, each input_size bytes, back to back.
+     * @param input_size the size of each input.
+     * @param domain the domain separation byte.
+     * @param out receives the outputs, back to back; each at most Rate bytes.
+     */
+    template<size_t Rate, size_t Rounds>
+    auto keccak_hash_each(std::span<uint8_t const> inputs, size_t input_size, uint8_t domain, std::span<uint8_t> out) -> void
+    {
+        auto const count{ inputs.size() / input_size };
+        auto const out_size{ out.size() / count };
+        size_t index{};
+#if defined(__AVX2__)
+        for (; index + 4 <= count; index += 4)
+        {
+            auto const* base{ inputs.data() + (index * input_size) };
+            auto const stride{ static_cast<long long>(input_size) };
+            auto const offsets{ _mm256_setr_epi64x(0, stride, 2 * stride, 3 * stride) };
+            auto const load_word{ [&](size_t offset) -> __m256i
+                {
+                    return _mm256_i64gather_epi64(reinterpret_cast<long long const*>(base + offset), offsets, 1);
+                } };
+
+            __m256i a[keccak::state_words];
+            for (auto& word : a)
+            {
+                word = _mm256_setzero_si256();
+            }
+
+            size_t offset{};
+            for (; offset + Rate <= input_size; offset += Rate)
+            {
+                for (size_t k = 0; k < Rate / sizeof(uint64_t); ++k)
+                {
+                    a[k] = _mm256_xor_si256(a[k], load_word(offset + (k * sizeof(uint64_t))));
+                }
+
+                keccak::permute<keccak_avx2_ops, Rounds>(a);
+            }
+
+            // the tail is padded one lane at a time through a scratch block
+            alignas(32) std::array<std::array<uint8_t, Rate>, 4> tails{};
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                std::copy_n(base + (lane * input_size) + offset, input_size - offset, tails[lane].begin());
+                tails[lane][input_size - offset] ^= domain;
+                tails[lane][Rate - 1] ^= 0x80;
+            }
+
+            for (size_t k = 0; k < Rate / sizeof(uint64_t); ++k)
+            {
+                a[k] = _mm256_xor_si256(a[k], _mm256_setr_epi64x(
+                    static_cast<long long>(keccak::load(tails[0].data() + (k * sizeof(uint64_t)))),
+                    static_cast<long long>(keccak::load(tails[1].data() + (k * sizeof(uint64_t)))),
+                    static_cast<long long>(keccak::load(tails[2].data() + (k * sizeof(uint64_t)))),
+                    static_cast<long long>(keccak::load(tails[3].data() + (k * sizeof(uint64_t))))));
+            }
+
+            keccak::permute<keccak_avx2_ops, Rounds>(a);
+            alignas(32) std::array<std::array<uint64_t, 4>, keccak::state_words> words{};
+            for (size_t k = 0; k < (out_size + sizeof(uint64_t) - 1) / sizeof(uint64_t); ++k)
+            {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(words[k].data()), a[k]);
+            }
+
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                for (size_t i = 0; i < out_size; ++i)
+                {
+                    out[((index + lane) * out_size) + i] = static_cast<uint8_t>(words[i / sizeof(uint64_t)][lane] >> (8 * (i % sizeof(uint64_t))));
+                }
+            }
+        }
+#endif
+        for (; index < count; ++index)
+        {
+            keccak_sponge<Rate, Rounds> sponge;
+            sponge.absorb(inputs.subspan(index * input_size, input_size));
+            sponge.pad(domain);
+            sponge.squeeze(out.subspan(index * out_size, out_size));
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/ranges/views/detail/keccak.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * The Keccak extendable-output functions: SHAKE128 and SHAKE256 (FIPS
+     * 202) and TurboSHAKE128 and TurboSHAKE256 (RFC 9861), which are SHAKE
+     * with 12 rounds of Keccak-p[1600] instead of 24. All use the default
+     * domain byte 0x1F.
+     *
+     * The output is squeezed lazily; hash() holds only the current rate
+     * block and next_block() moves on to the next one.
+     *
+     * @tparam A hash_algorithm::shake128, hash_algorithm::shake256,
+     * hash_algorithm::turboshake128, or hash_algorithm::turboshake256.
+     */
+    template<sph::hash_algorithm A>
+        requires (A == sph::hash_algorithm::shake128 || A == sph::hash_algorithm::shake256
+            || A == sph::hash_algorithm::turboshake128 || A == sph::hash_algorithm::turboshake256)
+    class keccak_xof
+    {
+        static constexpr size_t rate{ A == sph::hash_algorithm::shake128 || A == sph::hash_algorithm::turboshake128 ? 168 : 136 };
+        static constexpr size_t rounds{ A == sph::hash_algorithm::shake128 || A == sph::hash_algorithm::shake256 ? 24 : 12 };
+        static constexpr uint8_t domain{ 0x1F };
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<A>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<A>::chunk_size() };
+    private:
+        keccak_sponge<rate, rounds> sponge_;
+        keccak_output<rate> output_;
+        size_t hash_size_;
+    public:
+        explicit keccak_xof(size_t hash_byte_count)
+            : hash_size_{ hash_byte_count }
+        {
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return output_.block();
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            sponge_.absorb(data);
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            sponge_.absorb(data);
+            sponge_.pad(domain);
+            output_.first_block(sponge_, hash_size_);
+        }
+
+        auto next_block() -> void
+        {
+            output_.next_block(sponge_);
+        }
+    };
+
+    using shake128 = keccak_xof<sph::hash_algorithm::shake128>;
+    using shake256 = keccak_xof<sph::hash_algorithm::shake256>;
+    using turboshake128 = keccak_xof<sph::hash_algorithm::turboshake128>;
+    using turboshake256 = keccak_xof<sph::hash_algorithm::turboshake256>;
+}
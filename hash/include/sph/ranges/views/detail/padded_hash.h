@@ -189,6 +189,14 @@ namespace sph::ranges::views::detail
             return concat::first_second_range(hash_range, pad_span);
         }
 
+        /**
+         * \brief Gets the hash without its padding.
+         */
+        auto digest() const
+        {
+            return hash_.hash();
+        }
+
         /**
          * \brief Sets the target hash size.
          *
@@ -0,0 +1,266 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/parallel_hash_parameters.h>
+#include <sph/ranges/views/detail/keccak.h>
+#include <sph/ranges/views/detail/thread_pool.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * ParallelHash128 and ParallelHash256 (NIST SP 800-185).
+     *
+     * The input is cut into blocks of a configurable size. Each block is
+     * hashed on its own with cSHAKE (which, with no function name or
+     * customization, is plain SHAKE) to a chaining value of twice the
+     * security strength, and the final node, a cSHAKE named "ParallelHash",
+     * absorbs the chaining values in order. The output length is part of
+     * the final node's input, so unlike SHAKE a shorter hash is not a prefix
+     * of a longer one.
+     *
+     * Blocks are independent, so they are spread over the shared
+     * thread_pool, and within each task keccak_hash_each() hashes them four
+     * at a time in SIMD lanes when AVX2 is enabled at compile time. Streamed
+     * input is buffered a batch of blocks at a time; input handed over all at
+     * once to final() is hashed where it is.
+     *
+     * @tparam A hash_algorithm::parallelhash128 or hash_algorithm::parallelhash256.
+     */
+    template<sph::hash_algorithm A>
+        requires (A == sph::hash_algorithm::parallelhash128 || A == sph::hash_algorithm::parallelhash256)
+    class parallel_hash
+    {
+        static constexpr size_t rate{ A == sph::hash_algorithm::parallelhash128 ? 168 : 136 };
+        static constexpr size_t rounds{ 24 };
+        static constexpr size_t chaining_value_size{ A == sph::hash_algorithm::parallelhash128 ? 32 : 64 };
+        static constexpr uint8_t leaf_domain{ 0x1F };
+        static constexpr uint8_t cshake_domain{ 0x04 };
+        // roughly how much input each thread pool task hashes
+        static constexpr size_t task_bytes{ size_t{ 256 } * 1024 };
+        // the most streamed input buffered before it is hashed
+        static constexpr size_t max_batch_bytes{ size_t{ 16 } * 1024 * 1024 };
+        using sponge_t = keccak_sponge<rate, rounds>;
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<A>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<A>::chunk_size() };
+    private:
+        sponge_t final_node_;
+        size_t block_size_;
+        size_t blocks_per_task_;
+        size_t batch_size_{};
+        uint64_t block_count_{};
+        // streamed blocks not yet hashed; less than one batch
+        std::vector<uint8_t> blocks_;
+        std::vector<uint8_t> chaining_values_;
+        std::array<uint8_t, hash_size> hash_{};
+        size_t hash_size_;
+    public:
+        explicit parallel_hash(size_t hash_byte_count, sph::parallel_hash_parameters parameters = {})
+            : block_size_{ validate_block_size(parameters.block_size) }
+            , blocks_per_task_{ task_block_count(block_size_) }
+            , hash_size_{ hash_byte_count }
+        {
+            // bytepad(encode_string("ParallelHash") || encode_string(S), rate)
+            constexpr std::string_view function_name{ "ParallelHash" };
+            auto prefix{ left_encode(rate) };
+            append(prefix, left_encode(function_name.size() * 8));
+            prefix.insert(prefix.end(), function_name.begin(), function_name.end());
+            append(prefix, left_encode(parameters.customization.size() * 8));
+            append(prefix, parameters.customization);
+            prefix.resize(((prefix.size() + rate - 1) / rate) * rate);
+            final_node_.absorb(prefix);
+            final_node_.absorb(left_encode(block_size_));
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return { hash_.data(), hash_size_ };
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            absorb(data);
+        }
+
+        auto final(std::span<uint8_t const> data) -> void
+        {
+            // complete the last buffered block, then hash the rest in place
+            auto const fill{ std::min(data.size(), (block_size_ - (blocks_.size() % block_size_)) % block_size_) };
+            blocks_.insert(blocks_.end(), data.begin(), data.begin() + static_cast<ptrdiff_t>(fill));
+            data = data.subspan(fill);
+            std::span<uint8_t const> tail{ blocks_ };
+            if (!data.empty())
+            {
+                hash_blocks(blocks_);
+                tail = data;
+            }
+
+            auto const whole{ tail.size() - (tail.size() % block_size_) };
+            hash_blocks(tail.first(whole));
+            if (auto const last{ tail.subspan(whole) }; !last.empty())
+            {
+                chaining_values_.resize(chaining_value_size);
+                keccak_hash_each<rate, rounds>(last, last.size(), leaf_domain, chaining_values_);
+                final_node_.absorb(chaining_values_);
+                ++block_count_;
+            }
+
+            final_node_.absorb(right_encode(block_count_));
+            final_node_.absorb(right_encode(uint64_t{ hash_size_ } * 8));
+            final_node_.pad(cshake_domain);
+            final_node_.squeeze(std::span<uint8_t>{ hash_.data(), hash_size_ });
+        }
+
+    private:
+        static auto validate_block_size(size_t block_size) -> size_t
+        {
+            if (block_size == 0)
+            {
+                throw std::invalid_argument(std::format("{} block size must be at least 1 byte, got {}.", sph::hash_param<A>::name(), block_size));
+            }
+
+            return block_size;
+        }
+
+        /**
+         * Blocks per thread pool task: enough to make the task worth handing
+         * off, in whole groups of four SIMD lanes.
+         */
+        static auto task_block_count(size_t block_size) -> size_t
+        {
+            if (block_size >= task_bytes)
+            {
+                return 1;
+            }
+
+            auto const blocks{ (task_bytes + block_size - 1) / block_size };
+            return ((blocks + 3) / 4) * 4;
+        }
+
+        /**
+         * How much streamed input to gather before hashing it: a task for
+         * every thread in the pool, within max_batch_bytes.
+         */
+        auto batch_size() -> size_t
+        {
+            if (batch_size_ == 0)
+            {
+                auto const blocks{ std::clamp<size_t>(blocks_per_task_ * thread_pool::shared().size(), 1, std::max<size_t>(max_batch_bytes / block_size_, 1)) };
+                batch_size_ = blocks * block_size_;
+            }
+
+            return batch_size_;
+        }
+
+        /**
+         * Encode a value as its big-endian bytes, without leading zeros but
+         * at least one byte, preceded by the number of those bytes.
+         */
+        static auto left_encode(uint64_t value) -> std::vector<uint8_t>
+        {
+            auto encoded{ right_encode(value) };
+            std::rotate(encoded.begin(), encoded.end() - 1, encoded.end());
+            return encoded;
+        }
+
+        /**
+         * Encode a value as its big-endian bytes, without leading zeros but
+         * at least one byte, followed by the number of those bytes.
+         */
+        static auto right_encode(uint64_t value) -> std::vector<uint8_t>
+        {
+            std::vector<uint8_t> encoded{ static_cast<uint8_t>(value) };
+            for (value >>= 8; value != 0; value >>= 8)
+            {
+                encoded.insert(encoded.begin(), static_cast<uint8_t>(value));
+            }
+
+            encoded.push_back(static_cast<uint8_t>(encoded.size()));
+            return encoded;
+        }
+
+        static auto append(std::vector<uint8_t>& to, std::span<uint8_t const> bytes) -> void
+        {
+            to.insert(to.end(), bytes.begin(), bytes.end());
+        }
+
+        auto absorb(std::span<uint8_t const> data) -> void
+        {
+            auto const batch{ batch_size() };
+            while (!data.empty())
+            {
+                if (blocks_.empty() && data.size() >= batch)
+                {
+                    // hash whole batches in place; the tail is buffered below
+                    auto const direct{ data.size() - (data.size() % batch) };
+                    hash_blocks(data.first(direct));
+                    data = data.subspan(direct);
+                    continue;
+                }
+
+                auto const take{ std::min(batch - blocks_.size(), data.size()) };
+                blocks_.insert(blocks_.end(), data.begin(), data.begin() + static_cast<ptrdiff_t>(take));
+                data = data.subspan(take);
+                if (blocks_.size() == batch)
+                {
+                    hash_blocks(blocks_);
+                    blocks_.clear();
+                }
+            }
+        }
+
+        /**
+         * Hash whole blocks into chaining values, spread over the thread
+         * pool, and absorb them into the final node in order.
+         */
+        auto hash_blocks(std::span<uint8_t const> blocks) -> void
+        {
+            auto const count{ blocks.size() / block_size_ };
+            if (count == 0)
+            {
+                return;
+            }
+
+            chaining_values_.resize(count * chaining_value_size);
+            auto const task_count{ (count + blocks_per_task_ - 1) / blocks_per_task_ };
+            auto const hash_task{ [&](size_t task) -> void
+                {
+                    auto const first{ task * blocks_per_task_ };
+                    auto const task_blocks{ std::min(blocks_per_task_, count - first) };
+                    keccak_hash_each<rate, rounds>(
+                        blocks.subspan(first * block_size_, task_blocks * block_size_),
+                        block_size_,
+                        leaf_domain,
+                        std::span<uint8_t>{ chaining_values_ }.subspan(first * chaining_value_size, task_blocks * chaining_value_size));
+                } };
+            if (task_count == 1)
+            {
+                hash_task(0);
+            }
+            else
+            {
+                thread_pool::shared().run(task_count, hash_task);
+            }
+
+            final_node_.absorb(chaining_values_);
+            block_count_ += count;
+        }
+    };
+
+    using parallelhash128 = parallel_hash<sph::hash_algorithm::parallelhash128>;
+    using parallelhash256 = parallel_hash<sph::hash_algorithm::parallelhash256>;
+}
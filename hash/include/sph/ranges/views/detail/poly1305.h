@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <sodium/crypto_onetimeauth_poly1305.h>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/poly1305_parameters.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * Poly1305 one-time authenticator producing a 16-byte tag.
+     *
+     * The key is consumed by libsodium's init and is not kept by this class.
+     */
+    class poly1305
+    {
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<sph::hash_algorithm::poly1305>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<sph::hash_algorithm::poly1305>::chunk_size() };
+        static constexpr size_t key_size{ crypto_onetimeauth_poly1305_KEYBYTES };
+    private:
+        crypto_onetimeauth_poly1305_state state_;
+        std::array<uint8_t, hash_size> hash_{};
+        size_t hash_size_;
+    public:
+        explicit poly1305(size_t hash_byte_count, sph::poly1305_parameters parameters = {})
+            : state_{ init_state(parameters) }
+            , hash_size_{ hash_byte_count }
+        {
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return { hash_.data(), hash_size_ };
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            crypto_onetimeauth_poly1305_update(&state_, data.data(), data.size());
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            if (!data.empty())
+            {
+                crypto_onetimeauth_poly1305_update(&state_, data.data(), data.size());
+            }
+
+            crypto_onetimeauth_poly1305_final(&state_, hash_.data());
+        }
+
+    private:
+        static auto init_state(sph::poly1305_parameters parameters) -> crypto_onetimeauth_poly1305_state
+        {
+            if (parameters.key.size() != key_size)
+            {
+                throw std::invalid_argument(
+                    std::format("Poly1305 key length must be {} bytes, got {}.",
+                        key_size,
+                        parameters.key.size()));
+            }
+
+            crypto_onetimeauth_poly1305_state state;
+            crypto_onetimeauth_poly1305_init(&state, parameters.key.data());
+            return state;
+        }
+    };
+}
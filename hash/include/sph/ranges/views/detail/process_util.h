@@ -31,4 +31,15 @@ namespace sph::ranges::views::detail
         { hash.update(chunk) } -> std::same_as<void>;
         { hash.final(final_data) } -> std::same_as<void>;
     };
+
+    /**
+     * A hash with extendable output (an XOF). hash() only holds the current
+     * block of output; next_block() replaces it with the next one, so a long
+     * output is never materialized all at once.
+     */
+    template<typename T>
+    concept extendable_hash = basic_hash<T> && requires(T hash)
+    {
+        { hash.next_block() } -> std::same_as<void>;
+    };
 }
@@ -9,24 +9,43 @@
 #include <stdexcept>
 #include <tuple>
 #include <sph/hash_algorithm.h>
+#include <sph/hash_format.h>
 #include <sph/hash_param.h>
+#include <sph/ranges/views/detail/text_encoding.h>
 namespace sph::ranges::views::detail
 {
-    template<typename T, sph::hash_algorithm A>
+    /**
+     * Holds back the last bytes of a stream, enough for the largest hash
+     * appended to it, until the end of the stream shows which of them are
+     * the hash.
+     *
+     * @tparam T The element type of the stream.
+     * @tparam A The hash algorithm.
+     * @tparam F The hash format.
+     */
+    template<typename T, sph::hash_algorithm A, sph::hash_format F>
     class rolling_buffer
     {
-        std::array<uint8_t, sph::hash_param<A>::hash_byte_count()> buf_;
+        // a text hash is appended as its encoded characters; a padded hash
+        // gets its pad byte and zeros out to the next whole element
+        static constexpr size_t capacity{ encoded_size<F>(sph::hash_param<A>::hash_byte_count()) + (F == sph::hash_format::padded ? sizeof(T) : 0) };
+        std::array<uint8_t, capacity> buf_{};
         size_t end_{ 0 };
         size_t data_current_{ 0 };
         size_t data_end_{ std::numeric_limits<size_t>::max() };
     public:
+        /**
+         * Add the next byte of the stream.
+         * @return the byte it pushes out of the buffer, which can't be part
+         * of the hash; nothing while the buffer is still filling.
+         */
         auto next(uint8_t v) -> std::optional<uint8_t>
         {
             auto i{ end_ % buf_.size() };
             uint8_t ret{ buf_[i] };
             buf_[i] = v;
             ++end_;
-            return end_ > buf_.size() ? std::optional<uint8_t>{} : ret;
+            return end_ > buf_.size() ? ret : std::optional<uint8_t>{};
         }
         auto next() -> std::tuple<bool, uint8_t>
         {
@@ -57,6 +76,7 @@ namespace sph::ranges::views::detail
         }
         auto operator[](size_t i) const -> uint8_t { return buf_[(end_ + i + 1) % buf_.size()]; }
         auto size() const -> size_t { return buf_.size(); }
+        auto byte_count() const -> size_t { return end_; }
         auto done() const -> bool { return data_end_ != std::numeric_limits<size_t>::max(); }
         auto hash(size_t target_hash_size) const -> std::vector<uint8_t>
         {
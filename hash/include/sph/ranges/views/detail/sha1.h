@@ -0,0 +1,260 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#if defined(__SHA__) && defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * SHA-1 (FIPS 180-4), fed any number of bytes at a time.
+     *
+     * With the x86 SHA extensions enabled at compile time (e.g. -msha), blocks
+     * are compressed with the SHA-NI instructions; otherwise with portable
+     * code. SHA-1 is no longer collision resistant and is only here for
+     * formats that require it, such as git object ids.
+     */
+    class sha1_engine
+    {
+    public:
+        static constexpr size_t block_size{ 64 };
+        static constexpr size_t digest_size{ 20 };
+    private:
+        std::array<uint32_t, 5> state_{ 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+        std::array<uint8_t, block_size> buffer_{};
+        size_t buffered_{};
+        uint64_t length_{};
+    public:
+        auto update(std::span<uint8_t const> data) -> void
+        {
+            length_ += data.size();
+            if (buffered_ != 0)
+            {
+                auto const take{ std::min(block_size - buffered_, data.size()) };
+                std::copy_n(data.begin(), take, buffer_.begin() + static_cast<ptrdiff_t>(buffered_));
+                buffered_ += take;
+                data = data.subspan(take);
+                if (buffered_ < block_size)
+                {
+                    return;
+                }
+
+                compress(state_, buffer_.data(), 1);
+                buffered_ = 0;
+            }
+
+            auto const blocks{ data.size() / block_size };
+            if (blocks != 0)
+            {
+                compress(state_, data.data(), blocks);
+            }
+
+            data = data.subspan(blocks * block_size);
+            std::ranges::copy(data, buffer_.begin());
+            buffered_ = data.size();
+        }
+
+        auto final(std::span<uint8_t, digest_size> out) -> void
+        {
+            auto const bit_length{ length_ * 8 };
+            std::array<uint8_t, block_size * 2> padding{ 0x80 };
+            auto const padding_size{ (buffered_ < block_size - 8 ? block_size - 8 : (2 * block_size) - 8) - buffered_ };
+            for (size_t i = 0; i < 8; ++i)
+            {
+                padding[padding_size + i] = static_cast<uint8_t>(bit_length >> (56 - (8 * i)));
+            }
+
+            update(std::span<uint8_t const>{ padding.data(), padding_size + 8 });
+            for (size_t i = 0; i < state_.size(); ++i)
+            {
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    out[(4 * i) + j] = static_cast<uint8_t>(state_[i] >> (24 - (8 * j)));
+                }
+            }
+        }
+
+    private:
+        static auto compress(std::array<uint32_t, 5>& state, uint8_t const* blocks, size_t count) -> void
+        {
+#if defined(__SHA__) && defined(__SSE4_1__)
+            compress_sha_ni(state, blocks, count);
+#else
+            compress_portable(state, blocks, count);
+#endif
+        }
+
+#if defined(__SHA__) && defined(__SSE4_1__)
+        /**
+         * Four rounds; G is the group of four, 0 through 19. The message
+         * schedule for later groups is computed alongside.
+         */
+        template<int G>
+        static auto sha_ni_rounds(__m128i& abcd, __m128i (&e)[2], __m128i (&message)[4], uint8_t const* block) -> void
+        {
+            if constexpr (G < 4)
+            {
+                auto const byte_swap{ _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL) };
+                message[G] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(block + (16 * G))), byte_swap);
+            }
+
+            auto& e_next{ e[G % 2] };
+            if constexpr (G == 0)
+            {
+                e_next = _mm_add_epi32(e_next, message[0]);
+            }
+            else
+            {
+                e_next = _mm_sha1nexte_epu32(e_next, message[G % 4]);
+            }
+
+            e[(G + 1) % 2] = abcd;
+            if constexpr (G >= 3)
+            {
+                message[(G + 1) % 4] = _mm_sha1msg2_epu32(message[(G + 1) % 4], message[G % 4]);
+            }
+
+            abcd = _mm_sha1rnds4_epu32(abcd, e_next, G / 5);
+            if constexpr (G >= 1)
+            {
+                message[(G + 3) % 4] = _mm_sha1msg1_epu32(message[(G + 3) % 4], message[G % 4]);
+            }
+
+            if constexpr (G >= 2)
+            {
+                message[(G + 2) % 4] = _mm_xor_si128(message[(G + 2) % 4], message[G % 4]);
+            }
+        }
+
+        template<int... G>
+        static auto sha_ni_block(__m128i& abcd, __m128i (&e)[2], uint8_t const* block, std::integer_sequence<int, G...>) -> void
+        {
+            // a plain array keeps __m128i's alignment attribute
+            __m128i message[4]{};
+            (sha_ni_rounds<G>(abcd, e, message, block), ...);
+        }
+
+        static auto compress_sha_ni(std::array<uint32_t, 5>& state, uint8_t const* blocks, size_t count) -> void
+        {
+            auto abcd{ _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state.data())), 0x1B) };
+            __m128i e[2]{ _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0), _mm_setzero_si128() };
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto const abcd_saved{ abcd };
+                auto const e_saved{ e[0] };
+                sha_ni_block(abcd, e, blocks + (i * block_size), std::make_integer_sequence<int, 20>{});
+                e[0] = _mm_sha1nexte_epu32(e[0], e_saved);
+                abcd = _mm_add_epi32(abcd, abcd_saved);
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data()), _mm_shuffle_epi32(abcd, 0x1B));
+            state[4] = static_cast<uint32_t>(_mm_extract_epi32(e[0], 3));
+        }
+#else
+        static auto compress_portable(std::array<uint32_t, 5>& state, uint8_t const* blocks, size_t count) -> void
+        {
+            for (size_t block = 0; block < count; ++block)
+            {
+                auto const* bytes{ blocks + (block * block_size) };
+                std::array<uint32_t, 80> w{};
+                for (size_t t = 0; t < 16; ++t)
+                {
+                    w[t] = (static_cast<uint32_t>(bytes[4 * t]) << 24)
+                        | (static_cast<uint32_t>(bytes[(4 * t) + 1]) << 16)
+                        | (static_cast<uint32_t>(bytes[(4 * t) + 2]) << 8)
+                        | static_cast<uint32_t>(bytes[(4 * t) + 3]);
+                }
+
+                for (size_t t = 16; t < 80; ++t)
+                {
+                    w[t] = std::rotl(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+                }
+
+                auto [a, b, c, d, e] { state };
+                for (size_t t = 0; t < 80; ++t)
+                {
+                    uint32_t f{};
+                    uint32_t k{};
+                    if (t < 20)
+                    {
+                        f = (b & c) | (~b & d);
+                        k = 0x5A827999;
+                    }
+                    else if (t < 40)
+                    {
+                        f = b ^ c ^ d;
+                        k = 0x6ED9EBA1;
+                    }
+                    else if (t < 60)
+                    {
+                        f = (b & c) | (b & d) | (c & d);
+                        k = 0x8F1BBCDC;
+                    }
+                    else
+                    {
+                        f = b ^ c ^ d;
+                        k = 0xCA62C1D6;
+                    }
+
+                    auto const temp{ std::rotl(a, 5) + f + e + k + w[t] };
+                    e = d;
+                    d = c;
+                    c = std::rotl(b, 30);
+                    b = a;
+                    a = temp;
+                }
+
+                state[0] += a;
+                state[1] += b;
+                state[2] += c;
+                state[3] += d;
+                state[4] += e;
+            }
+        }
+#endif
+    };
+
+    class sha1
+    {
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<sph::hash_algorithm::sha1>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<sph::hash_algorithm::sha1>::chunk_size() };
+    private:
+        size_t hash_size_;
+        sha1_engine engine_;
+        std::array<uint8_t, hash_size> hash_{};
+    public:
+        sha1(size_t hash_byte_count)
+            : hash_size_{ hash_byte_count }
+        {
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return { hash_.data(), hash_size_ };
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            engine_.update(data);
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            engine_.update(data);
+            engine_.final(hash_);
+        }
+    };
+}
@@ -1,22 +1,40 @@
 #pragma once
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <iterator>
+#include <span>
 #include <sodium/crypto_hash_sha512.h>
 #include <sph/hash_algorithm.h>
 #include <sph/hash_param.h>
 
 namespace sph::ranges::views::detail
 {
-    class sha512
+    /**
+     * SHA-512 and its truncated variants SHA-512/256 and SHA-512/224 (FIPS
+     * 180-4).
+     *
+     * The truncated variants run the same 64-bit compression function from
+     * libsodium but start from their own initial hash values, so they are
+     * not simply a prefix of SHA-512.
+     *
+     * @tparam A hash_algorithm::sha512, hash_algorithm::sha512_256, or
+     * hash_algorithm::sha512_224.
+     */
+    template<sph::hash_algorithm A>
+        requires (A == sph::hash_algorithm::sha512 || A == sph::hash_algorithm::sha512_256 || A == sph::hash_algorithm::sha512_224)
+    class basic_sha512
     {
     public:
-        static constexpr size_t hash_size{ sph::hash_param<sph::hash_algorithm::sha512>::hash_byte_count() };
-        static constexpr size_t chunk_size{ sph::hash_param<sph::hash_algorithm::sha512>::chunk_size() };
+        static constexpr size_t hash_size{ sph::hash_param<A>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<A>::chunk_size() };
     private:
         size_t hash_size_{};
         crypto_hash_sha512_state state_;
-        std::array<uint8_t, hash_size> hash_{};
+        // always the full SHA-512 state; the truncated variants use its front
+        std::array<uint8_t, crypto_hash_sha512_BYTES> hash_{};
     public:
-        sha512(size_t hash_byte_count)
+        basic_sha512(size_t hash_byte_count)
             : hash_size_{ hash_byte_count }
             , state_{ init_state() }
         {
@@ -52,7 +70,26 @@ namespace sph::ranges::views::detail
         {
             crypto_hash_sha512_state state;
             crypto_hash_sha512_init(&state);
+            if constexpr (A == sph::hash_algorithm::sha512_256)
+            {
+                constexpr std::array<uint64_t, 8> iv{
+                    0x22312194FC2BF72CULL, 0x9F555FA3C84C64C2ULL, 0x2393B86B6F53B151ULL, 0x963877195940EABDULL,
+                    0x96283EE2A88EFFE3ULL, 0xBE5E1E2553863992ULL, 0x2B0199FC2C85B8AAULL, 0x0EB72DDC81C52CA2ULL };
+                std::ranges::copy(iv, std::begin(state.state));
+            }
+            else if constexpr (A == sph::hash_algorithm::sha512_224)
+            {
+                constexpr std::array<uint64_t, 8> iv{
+                    0x8C3D37C819544DA2ULL, 0x73E1996689DCD4D6ULL, 0x1DFAB7AE32FF9C82ULL, 0x679DD514582F9FCFULL,
+                    0x0F6D2B697BD44DA8ULL, 0x77E36F7304C48942ULL, 0x3F9D85A86A1D36C8ULL, 0x1112E6AD91D692A1ULL };
+                std::ranges::copy(iv, std::begin(state.state));
+            }
+
             return state;
         }
     };
-}
\ No newline at end of file
+
+    using sha512 = basic_sha512<sph::hash_algorithm::sha512>;
+    using sha512_256 = basic_sha512<sph::hash_algorithm::sha512_256>;
+    using sha512_224 = basic_sha512<sph::hash_algorithm::sha512_224>;
+}
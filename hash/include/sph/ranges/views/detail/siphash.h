@@ -0,0 +1,196 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <sodium/crypto_shorthash_siphash24.h>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_param.h>
+#include <sph/siphash_parameters.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * SipHash-2-4 with a 64-bit (siphash24) or 128-bit (siphashx24) output.
+     *
+     * SipHash is meant for short inputs, so the common case is a single call
+     * to final() with the whole input; that goes straight to libsodium's
+     * one-shot crypto_shorthash. libsodium has no incremental SipHash, so
+     * input that arrives through update() runs through the SipHash rounds
+     * here instead.
+     *
+     * @tparam A hash_algorithm::siphash24 or hash_algorithm::siphashx24.
+     */
+    template<sph::hash_algorithm A>
+        requires (A == sph::hash_algorithm::siphash24 || A == sph::hash_algorithm::siphashx24)
+    class siphash
+    {
+    public:
+        static constexpr size_t hash_size{ sph::hash_param<A>::hash_byte_count() };
+        static constexpr size_t chunk_size{ sph::hash_param<A>::chunk_size() };
+        static constexpr size_t key_size{ crypto_shorthash_siphash24_KEYBYTES };
+    private:
+        static constexpr bool wide{ A == sph::hash_algorithm::siphashx24 };
+        static_assert(chunk_size % sizeof(uint64_t) == 0);
+        std::array<uint8_t, key_size> key_;
+        std::array<uint64_t, 4> v_;
+        uint64_t length_{};
+        std::array<uint8_t, hash_size> hash_{};
+        size_t hash_size_;
+    public:
+        explicit siphash(size_t hash_byte_count, sph::siphash_parameters parameters = {})
+            : key_{ init_key(parameters) }
+            , v_{ init_state(key_) }
+            , hash_size_{ hash_byte_count }
+        {
+        }
+
+        auto target_hash_size() const -> size_t
+        {
+            return hash_size_;
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return { hash_.data(), hash_size_ };
+        }
+
+        auto update(std::span<uint8_t const, chunk_size> const data) -> void
+        {
+            compress(data);
+            length_ += data.size();
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            if (length_ == 0)
+            {
+                if constexpr (wide)
+                {
+                    crypto_shorthash_siphashx24(hash_.data(), data.data(), data.size(), key_.data());
+                }
+                else
+                {
+                    crypto_shorthash_siphash24(hash_.data(), data.data(), data.size(), key_.data());
+                }
+
+                return;
+            }
+
+            auto const full_word_bytes{ data.size() - (data.size() % sizeof(uint64_t)) };
+            compress(data.first(full_word_bytes));
+            length_ += data.size();
+
+            // The last word holds the remaining bytes and the low byte of the
+            // total length in its high byte.
+            uint64_t last{ (length_ & 0xff) << 56 };
+            auto const tail{ data.subspan(full_word_bytes) };
+            for (size_t i = 0; i < tail.size(); ++i)
+            {
+                last |= static_cast<uint64_t>(tail[i]) << (8 * i);
+            }
+
+            compress_word(last);
+            v_[2] ^= wide ? 0xee : 0xff;
+            rounds<4>();
+            store(v_[0] ^ v_[1] ^ v_[2] ^ v_[3], std::span<uint8_t, sizeof(uint64_t)>{ hash_.data(), sizeof(uint64_t) });
+            if constexpr (wide)
+            {
+                v_[1] ^= 0xdd;
+                rounds<4>();
+                store(v_[0] ^ v_[1] ^ v_[2] ^ v_[3], std::span<uint8_t, sizeof(uint64_t)>{ hash_.data() + sizeof(uint64_t), sizeof(uint64_t) });
+            }
+        }
+
+    private:
+        static auto init_key(sph::siphash_parameters parameters) -> std::array<uint8_t, key_size>
+        {
+            if (parameters.key.size() != key_size)
+            {
+                throw std::invalid_argument(
+                    std::format("SipHash key length must be {} bytes, got {}.",
+                        key_size,
+                        parameters.key.size()));
+            }
+
+            std::array<uint8_t, key_size> key{};
+            std::ranges::copy(parameters.key, key.begin());
+            return key;
+        }
+
+        static auto init_state(std::array<uint8_t, key_size> const& key) -> std::array<uint64_t, 4>
+        {
+            auto const k0{ load(std::span<uint8_t const, sizeof(uint64_t)>{ key.data(), sizeof(uint64_t) }) };
+            auto const k1{ load(std::span<uint8_t const, sizeof(uint64_t)>{ key.data() + sizeof(uint64_t), sizeof(uint64_t) }) };
+            return {
+                k0 ^ 0x736f6d6570736575ULL,
+                k1 ^ 0x646f72616e646f6dULL ^ (wide ? 0xeeULL : 0ULL),
+                k0 ^ 0x6c7967656e657261ULL,
+                k1 ^ 0x7465646279746573ULL
+            };
+        }
+
+        static auto load(std::span<uint8_t const, sizeof(uint64_t)> bytes) -> uint64_t
+        {
+            uint64_t ret{};
+            for (size_t i = 0; i < sizeof(uint64_t); ++i)
+            {
+                ret |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+            }
+
+            return ret;
+        }
+
+        static auto store(uint64_t value, std::span<uint8_t, sizeof(uint64_t)> bytes) -> void
+        {
+            for (size_t i = 0; i < sizeof(uint64_t); ++i)
+            {
+                bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        auto compress(std::span<uint8_t const> data) -> void
+        {
+            for (size_t i = 0; i < data.size(); i += sizeof(uint64_t))
+            {
+                compress_word(load(data.subspan(i).template first<sizeof(uint64_t)>()));
+            }
+        }
+
+        auto compress_word(uint64_t m) -> void
+        {
+            v_[3] ^= m;
+            rounds<2>();
+            v_[0] ^= m;
+        }
+
+        template<size_t N>
+        auto rounds() -> void
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                v_[0] += v_[1];
+                v_[1] = std::rotl(v_[1], 13);
+                v_[1] ^= v_[0];
+                v_[0] = std::rotl(v_[0], 32);
+                v_[2] += v_[3];
+                v_[3] = std::rotl(v_[3], 16);
+                v_[3] ^= v_[2];
+                v_[0] += v_[3];
+                v_[3] = std::rotl(v_[3], 21);
+                v_[3] ^= v_[0];
+                v_[2] += v_[1];
+                v_[1] = std::rotl(v_[1], 17);
+                v_[1] ^= v_[2];
+                v_[2] = std::rotl(v_[2], 32);
+            }
+        }
+    };
+
+    using siphash24 = siphash<sph::hash_algorithm::siphash24>;
+    using siphashx24 = siphash<sph::hash_algorithm::siphashx24>;
+}
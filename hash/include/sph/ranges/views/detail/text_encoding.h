@@ -0,0 +1,466 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <sph/hash_format.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * Whether the hash format writes the hash as text.
+     */
+    constexpr auto is_text_format(sph::hash_format format) -> bool
+    {
+        return format == sph::hash_format::hex || format == sph::hash_format::hex_upper || format == sph::hash_format::base64url;
+    }
+
+    /**
+     * The number of characters the hash format writes for a hash of the
+     * given size. Raw and padded hashes are the size itself.
+     */
+    template<sph::hash_format F>
+    constexpr auto encoded_size(size_t hash_size) -> size_t
+    {
+        if constexpr (F == sph::hash_format::hex || F == sph::hash_format::hex_upper)
+        {
+            return hash_size * 2;
+        }
+        else if constexpr (F == sph::hash_format::base64url)
+        {
+            // unpadded: 4 characters per 3 bytes, 2 or 3 for a final 1 or 2
+            return (hash_size * 4 + 2) / 3;
+        }
+        else
+        {
+            return hash_size;
+        }
+    }
+
+    /**
+     * Write bytes as hex, four bytes to eight characters at a time.
+     *
+     * Each group of four bytes is spread out to one nibble per byte of a
+     * 64-bit word, and all eight nibbles become characters in a few
+     * word-wide adds; there is no per-character branch or table lookup.
+     * @param bytes The bytes to encode.
+     * @param out Where to write the 2 * bytes.size() characters.
+     * @param upper Whether to use 'A'-'F' rather than 'a'-'f'.
+     */
+    inline auto encode_hex(std::span<uint8_t const> bytes, uint8_t* out, bool upper) -> void
+    {
+        uint64_t const letter_offset{ upper ? uint64_t{ 'A' - '0' - 10 } : uint64_t{ 'a' - '0' - 10 } };
+        auto const encode_four{ [letter_offset](uint32_t v, uint8_t* to) -> void
+            {
+                uint64_t x{ v };
+                x = (x | (x << 16)) & 0x0000FFFF0000FFFF;
+                x = (x | (x << 8)) & 0x00FF00FF00FF00FF;
+                x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0F;
+                auto const letters{ ((x + 0x0606060606060606) >> 4) & 0x0101010101010101 };
+                x += 0x3030303030303030 + letters * letter_offset;
+                if constexpr (std::endian::native == std::endian::little)
+                {
+                    x = std::byteswap(x);
+                }
+
+                std::memcpy(to, &x, sizeof(x));
+            } };
+        size_t i{};
+        for (; i + 4 <= bytes.size(); i += 4)
+        {
+            uint32_t v{ static_cast<uint32_t>(bytes[i]) << 24 | static_cast<uint32_t>(bytes[i + 1]) << 16 | static_cast<uint32_t>(bytes[i + 2]) << 8 | bytes[i + 3] };
+            encode_four(v, out + i * 2);
+        }
+
+        if (i < bytes.size())
+        {
+            uint32_t v{};
+            for (size_t k = 0; k < 4; ++k)
+            {
+                v = v << 8 | (i + k < bytes.size() ? bytes[i + k] : uint32_t{});
+            }
+
+            std::array<uint8_t, 8> tail{};
+            encode_four(v, tail.data());
+            std::memcpy(out + i * 2, tail.data(), (bytes.size() - i) * 2);
+        }
+    }
+
+    /**
+     * Write bytes as unpadded base64url (RFC 4648 section 5), three bytes
+     * to four characters at a time.
+     * @param bytes The bytes to encode.
+     * @param out Where to write the encoded_size<base64url>(bytes.size())
+     * characters.
+     */
+    inline auto encode_base64url(std::span<uint8_t const> bytes, uint8_t* out) -> void
+    {
+        static constexpr std::array<char, 65> alphabet{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_" };
+        size_t i{};
+        for (; i + 3 <= bytes.size(); i += 3)
+        {
+            uint32_t const v{ static_cast<uint32_t>(bytes[i]) << 16 | static_cast<uint32_t>(bytes[i + 1]) << 8 | bytes[i + 2] };
+            *out++ = static_cast<uint8_t>(alphabet[(v >> 18) & 0x3F]);
+            *out++ = static_cast<uint8_t>(alphabet[(v >> 12) & 0x3F]);
+            *out++ = static_cast<uint8_t>(alphabet[(v >> 6) & 0x3F]);
+            *out++ = static_cast<uint8_t>(alphabet[v & 0x3F]);
+        }
+
+        if (auto const remaining{ bytes.size() - i }; remaining != 0)
+        {
+            uint32_t const v{ static_cast<uint32_t>(bytes[i]) << 16 | (remaining == 2 ? static_cast<uint32_t>(bytes[i + 1]) << 8 : uint32_t{}) };
+            *out++ = static_cast<uint8_t>(alphabet[(v >> 18) & 0x3F]);
+            *out++ = static_cast<uint8_t>(alphabet[(v >> 12) & 0x3F]);
+            if (remaining == 2)
+            {
+                *out = static_cast<uint8_t>(alphabet[(v >> 6) & 0x3F]);
+            }
+        }
+    }
+
+    /**
+     * Write bytes in the given text format.
+     * @param bytes The bytes to encode.
+     * @param out Where to write the encoded_size<F>(bytes.size()) characters.
+     */
+    template<sph::hash_format F>
+    auto encode_text(std::span<uint8_t const> bytes, uint8_t* out) -> void
+    {
+        if constexpr (F == sph::hash_format::base64url)
+        {
+            encode_base64url(bytes, out);
+        }
+        else
+        {
+            encode_hex(bytes, out, F == sph::hash_format::hex_upper);
+        }
+    }
+
+    /**
+     * The value of a hex digit, either case, or 0x100 or more if c is not
+     * one. Computed with masks rather than branches or a table, so decoding
+     * an expected digest doesn't leak its value through timing.
+     */
+    constexpr auto hex_digit_value(uint8_t c) -> uint32_t
+    {
+        uint32_t const digit{ static_cast<uint32_t>(c) - '0' };
+        uint32_t const letter{ (static_cast<uint32_t>(c) | 0x20) - 'a' };
+        uint32_t const digit_ok{ 0 - static_cast<uint32_t>(digit < 10) };
+        uint32_t const letter_ok{ 0 - static_cast<uint32_t>(letter < 6) };
+        return (digit & digit_ok) | ((letter + 10) & letter_ok) | (0x100 & ~(digit_ok | letter_ok));
+    }
+
+    /**
+     * The value of a base64url character, or 0x100 or more if c is not one.
+     */
+    constexpr auto base64url_value(uint8_t c) -> uint32_t
+    {
+        auto const offset{ [c](uint32_t first) -> uint32_t { return static_cast<uint32_t>(c) - first; } };
+        auto const in_range{ [&offset](uint32_t first, uint32_t count) -> uint32_t { return 0 - static_cast<uint32_t>(offset(first) < count); } };
+        auto const upper{ in_range('A', 26) };
+        auto const lower{ in_range('a', 26) };
+        auto const digit{ in_range('0', 10) };
+        auto const dash{ in_range('-', 1) };
+        auto const underscore{ in_range('_', 1) };
+        return (offset('A') & upper)
+            | ((offset('a') + 26) & lower)
+            | ((offset('0') + 52) & digit)
+            | (62u & dash)
+            | (63u & underscore)
+            | (0x100u & ~(upper | lower | digit | dash | underscore));
+    }
+
+    /**
+     * Decode text in the given format. Hex is accepted in either case.
+     * @param text The encoded hash.
+     * @return the bytes, or nothing if text isn't validly encoded.
+     */
+    template<sph::hash_format F>
+    auto decode_text(std::span<uint8_t const> text) -> std::optional<std::vector<uint8_t>>
+    {
+        std::vector<uint8_t> ret;
+        uint32_t invalid{};
+        if constexpr (F == sph::hash_format::base64url)
+        {
+            if (text.size() % 4 == 1)
+            {
+                return std::nullopt;
+            }
+
+            ret.resize(text.size() * 3 / 4);
+            uint32_t v{};
+            size_t bits{};
+            size_t out{};
+            for (auto c : text)
+            {
+                auto const value{ base64url_value(c) };
+                invalid |= value;
+                v = (v << 6 | (value & 0x3F)) & 0xFFFFFF;
+                bits += 6;
+                if (bits >= 8)
+                {
+                    bits -= 8;
+                    ret[out++] = static_cast<uint8_t>(v >> bits);
+                }
+            }
+
+            // the unused low bits of the last character must be zero
+            invalid |= (v & ((1u << bits) - 1)) << 8;
+        }
+        else
+        {
+            if (text.size() % 2 != 0)
+            {
+                return std::nullopt;
+            }
+
+            ret.resize(text.size() / 2);
+            for (size_t i = 0; i < ret.size(); ++i)
+            {
+                auto const high{ hex_digit_value(text[i * 2]) };
+                auto const low{ hex_digit_value(text[i * 2 + 1]) };
+                invalid |= high | low;
+                ret[i] = static_cast<uint8_t>((high << 4 | low) & 0xFF);
+            }
+        }
+
+        if ((invalid & ~uint32_t{ 0xFF }) != 0)
+        {
+            return std::nullopt;
+        }
+
+        return ret;
+    }
+
+    /**
+     * The value of a base64 character from either the standard or the url
+     * alphabet, or 0xFF if c is not one. For decoding input, which isn't
+     * secret, so a table lookup is fine.
+     */
+    constexpr auto base64_input_value(uint8_t c) -> uint8_t
+    {
+        constexpr auto table{ []() -> std::array<uint8_t, 256>
+            {
+                std::array<uint8_t, 256> ret{};
+                ret.fill(0xFF);
+                for (uint8_t i = 0; i < 26; ++i)
+                {
+                    ret[static_cast<size_t>('A' + i)] = i;
+                    ret[static_cast<size_t>('a' + i)] = static_cast<uint8_t>(26 + i);
+                }
+
+                for (uint8_t i = 0; i < 10; ++i)
+                {
+                    ret[static_cast<size_t>('0' + i)] = static_cast<uint8_t>(52 + i);
+                }
+
+                ret['+'] = ret['-'] = 62;
+                ret['/'] = ret['_'] = 63;
+                return ret;
+            }() };
+        return table[c];
+    }
+
+    /**
+     * Decode one base64 quantum of 2 to 4 characters into 1 to 3 bytes.
+     * Throws std::invalid_argument on a character outside the alphabets.
+     */
+    inline auto decode_base64_quantum(std::span<uint8_t const> text, uint8_t* out) -> void
+    {
+        uint32_t v{};
+        for (size_t i = 0; i < 4; ++i)
+        {
+            uint32_t value{};
+            if (i < text.size())
+            {
+                value = base64_input_value(text[i]);
+                if (value == 0xFF)
+                {
+                    throw std::invalid_argument(std::format("Invalid base64 character {:#04x}.", text[i]));
+                }
+            }
+
+            v = v << 6 | value;
+        }
+
+        for (size_t i = 0; i + 1 < text.size(); ++i)
+        {
+            out[i] = static_cast<uint8_t>(v >> (16 - i * 8));
+        }
+    }
+
+    /**
+     * Decode eight hex digits, either case, into four bytes with 64-bit
+     * word arithmetic: every digit is range-checked and converted at once.
+     * @return false if any of the eight characters isn't a hex digit.
+     */
+    inline auto decode_hex8(uint8_t const* text, uint8_t* out) -> bool
+    {
+        constexpr uint64_t ones{ 0x0101010101010101 };
+        constexpr uint64_t high_bits{ 0x8080808080808080 };
+        uint64_t x{};
+        std::memcpy(&x, text, sizeof(x));
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            x = std::byteswap(x);
+        }
+
+        // bytes under 0x80 can't carry into their neighbor in the adds below
+        auto const ascii{ (x & high_bits) == 0 };
+        auto const lower{ x | ones * 0x20 };
+        auto const in_range{ [](uint64_t w, uint8_t first, uint8_t last) -> uint64_t
+            {
+                return (w + ones * (0x80u - first)) & ~(w + ones * (0x7Fu - last)) & high_bits;
+            } };
+        if (!ascii || (in_range(x, '0', '9') | in_range(lower, 'a', 'f')) != high_bits)
+        {
+            return false;
+        }
+
+        auto v{ (lower & ones * 0x0F) + ((lower >> 6) & ones) * 9 };
+        v = (v | v >> 4) & 0x00FF00FF00FF00FF;
+        v = (v | v >> 8) & 0x0000FFFF0000FFFF;
+        auto const bytes{ static_cast<uint32_t>(v | v >> 16) };
+        out[0] = static_cast<uint8_t>(bytes >> 24);
+        out[1] = static_cast<uint8_t>(bytes >> 16);
+        out[2] = static_cast<uint8_t>(bytes >> 8);
+        out[3] = static_cast<uint8_t>(bytes);
+        return true;
+    }
+
+    /**
+     * Decodes contiguous hex or base64 text a piece at a time, straight
+     * into a caller's buffer such as a hash's chunk staging buffer.
+     *
+     * Hex is read in either case. Base64 may use the standard or the url
+     * alphabet, with or without trailing '=' padding. Input that isn't
+     * validly encoded throws std::invalid_argument.
+     *
+     * @tparam F The text format: hex, hex_upper, or base64url.
+     */
+    template<sph::hash_format F>
+    class text_decoder
+    {
+        static_assert(is_text_format(F), "text_decoder needs a text hash format.");
+        static constexpr bool base64{ F == sph::hash_format::base64url };
+        std::span<uint8_t const> text_;
+        // the part of a base64 quantum that didn't fit in the last read
+        std::array<uint8_t, 3> pending_{};
+        size_t pending_begin_{};
+        size_t pending_end_{};
+    public:
+        explicit text_decoder(std::span<uint8_t const> text)
+            : text_{ text }
+        {
+            if constexpr (base64)
+            {
+                while (!text_.empty() && text_.back() == '=')
+                {
+                    text_ = text_.first(text_.size() - 1);
+                }
+
+                if (text_.size() % 4 == 1)
+                {
+                    throw std::invalid_argument(std::format("Truncated base64 input of {} characters.", text_.size()));
+                }
+            }
+            else if (text_.size() % 2 != 0)
+            {
+                throw std::invalid_argument(std::format("Odd number of hex digits, {}.", text_.size()));
+            }
+        }
+
+        /**
+         * Whether all the text has been decoded and read.
+         */
+        auto done() const -> bool
+        {
+            return text_.empty() && pending_begin_ == pending_end_;
+        }
+
+        /**
+         * Decode the next bytes.
+         * @param out Where to write them.
+         * @return the number of bytes written; less than out.size() only
+         * once all the text has been read.
+         */
+        auto read(std::span<uint8_t> out) -> size_t
+        {
+            size_t n{};
+            while (n < out.size() && pending_begin_ < pending_end_)
+            {
+                out[n++] = pending_[pending_begin_++];
+            }
+
+            if constexpr (base64)
+            {
+                while (n < out.size() && !text_.empty())
+                {
+                    auto const count{ std::min<size_t>(text_.size(), 4) };
+                    auto const bytes{ count - 1 };
+                    if (out.size() - n >= bytes)
+                    {
+                        decode_base64_quantum(text_.first(count), out.data() + n);
+                        n += bytes;
+                    }
+                    else
+                    {
+                        decode_base64_quantum(text_.first(count), pending_.data());
+                        pending_begin_ = 0;
+                        pending_end_ = bytes;
+                        while (n < out.size())
+                        {
+                            out[n++] = pending_[pending_begin_++];
+                        }
+                    }
+
+                    text_ = text_.subspan(count);
+                }
+            }
+            else
+            {
+                for (; out.size() - n >= 4 && text_.size() >= 8; n += 4, text_ = text_.subspan(8))
+                {
+                    if (!decode_hex8(text_.data(), out.data() + n))
+                    {
+                        throw std::invalid_argument("Invalid hex digit in encoded input.");
+                    }
+                }
+
+                for (; n < out.size() && !text_.empty(); ++n, text_ = text_.subspan(2))
+                {
+                    auto const value{ hex_digit_value(text_[0]) << 4 | hex_digit_value(text_[1]) };
+                    if (value > 0xFF)
+                    {
+                        throw std::invalid_argument("Invalid hex digit in encoded input.");
+                    }
+
+                    out[n] = static_cast<uint8_t>(value);
+                }
+            }
+
+            return n;
+        }
+    };
+
+    /**
+     * An iterator over decoded text that can hand back the rest of its text,
+     * undecoded, when that text is contiguous; for decoding it straight into
+     * a hash's staging buffer.
+     */
+    template <typename I>
+    concept contiguous_encoded_iterator = requires(I i, I const ci)
+    {
+        { I::encoding } -> std::convertible_to<sph::hash_format>;
+        { ci.encoded() } -> std::same_as<std::span<uint8_t const>>;
+        { i.consume() } -> std::same_as<void>;
+    };
+}
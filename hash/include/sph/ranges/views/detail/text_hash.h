@@ -0,0 +1,93 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <sph/hash_format.h>
+#include <sph/ranges/views/detail/process_util.h>
+#include <sph/ranges/views/detail/text_encoding.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * Wraps a hash so its output is the hash written as text.
+     *
+     * The whole hash is encoded in one pass when it is finalized, so the
+     * view hands out characters the same way it hands out raw hash bytes.
+     * The target hash size given to the constructor is the size of the
+     * hash in bytes; target_hash_size() is the number of characters.
+     *
+     * @tparam F The text format: hex, hex_upper, or base64url.
+     * @tparam H The hash.
+     */
+    template<sph::hash_format F, basic_hash H>
+    class text_hash
+    {
+        static_assert(is_text_format(F), "text_hash needs a text hash format.");
+        H hash_;
+        std::array<uint8_t, encoded_size<F>(H::hash_size)> text_{};
+    public:
+        template <typename... Args>
+        explicit text_hash(size_t hash_size, Args&&... args)
+            : hash_{ hash_size, std::forward<Args>(args)... }
+        {
+        }
+
+        auto hash() const -> std::span<uint8_t const>
+        {
+            return { text_.data(), target_hash_size() };
+        }
+
+        /**
+         * \brief Gets the hash bytes before they are encoded. Only the first
+         * block of extendable output.
+         */
+        auto digest() const
+        {
+            return hash_.hash();
+        }
+
+        /**
+         * \brief Gets the length of the encoded hash in characters.
+         */
+        auto target_hash_size() const -> size_t
+        {
+            return encoded_size<F>(hash_.target_hash_size());
+        }
+
+        auto update(std::span<uint8_t const, H::chunk_size> const& chunk) -> void
+        {
+            hash_.update(chunk);
+        }
+
+        auto final(std::span<uint8_t const> const data) -> void
+        {
+            hash_.final(data);
+            std::array<uint8_t, H::hash_size> bytes{};
+            auto const size{ hash_.target_hash_size() };
+            size_t copied{};
+            while (true)
+            {
+                auto block{ hash_.hash() };
+                auto const take{ std::min(static_cast<size_t>(std::ranges::size(block)), size - copied) };
+                std::ranges::copy_n(std::ranges::begin(block), static_cast<ptrdiff_t>(take), bytes.begin() + static_cast<ptrdiff_t>(copied));
+                copied += take;
+                if constexpr (extendable_hash<H>)
+                {
+                    if (copied < size)
+                    {
+                        hash_.next_block();
+                        continue;
+                    }
+                }
+
+                break;
+            }
+
+            encode_text<F>({ bytes.data(), size }, text_.data());
+        }
+    };
+}
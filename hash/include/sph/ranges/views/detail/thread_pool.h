@@ -0,0 +1,180 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * A fixed set of worker threads for splitting one hash across cores.
+     *
+     * run() hands out task indexes to the workers and the calling thread
+     * alike and returns once every task is done. One run() uses the pool at
+     * a time; concurrent callers wait their turn. A task that calls run()
+     * itself, on this or any other pool, runs the nested tasks on its own
+     * thread rather than waiting for a pool it may be holding.
+     */
+    class thread_pool
+    {
+        std::mutex run_mutex_;
+        std::mutex mutex_;
+        std::condition_variable work_ready_;
+        std::condition_variable work_done_;
+        std::function<void(size_t)> const* task_{};
+        size_t next_task_{};
+        size_t task_count_{};
+        size_t tasks_remaining_{};
+        std::exception_ptr error_{};
+        bool stopping_{ false };
+        std::vector<std::jthread> workers_;
+
+        // set while this thread runs a task from any pool
+        static inline thread_local bool running_task_{ false };
+    public:
+        /**
+         * @param worker_count the number of threads besides the caller of run().
+         */
+        explicit thread_pool(size_t worker_count)
+        {
+            workers_.reserve(worker_count);
+            for (size_t i = 0; i < worker_count; ++i)
+            {
+                workers_.emplace_back([this] { work(); });
+            }
+        }
+
+        thread_pool(thread_pool const&) = delete;
+        thread_pool(thread_pool&&) = delete;
+        auto operator=(thread_pool const&) -> thread_pool& = delete;
+        auto operator=(thread_pool&&) -> thread_pool& = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::scoped_lock lock{ mutex_ };
+                stopping_ = true;
+            }
+
+            work_ready_.notify_all();
+        }
+
+        /**
+         * The pool shared by all hashes, with one thread per hardware thread.
+         */
+        static auto shared() -> thread_pool&
+        {
+            static thread_pool pool{ std::max(std::thread::hardware_concurrency(), 1U) - 1 };
+            return pool;
+        }
+
+        /**
+         * The number of threads that run() spreads tasks over, including the
+         * caller.
+         */
+        auto size() const -> size_t
+        {
+            return workers_.size() + 1;
+        }
+
+        /**
+         * Call task(i) for every i in [0, task_count), in no particular order
+         * and on any thread, and wait for all of them to finish.
+         *
+         * Called from inside a task, the nested tasks run in order on the
+         * calling thread. If a task throws, tasks not yet started are
+         * skipped and run() rethrows the first exception once the running
+         * ones finish.
+         */
+        auto run(size_t task_count, std::function<void(size_t)> const& task) -> void
+        {
+            if (running_task_)
+            {
+                for (size_t i = 0; i < task_count; ++i)
+                {
+                    task(i);
+                }
+
+                return;
+            }
+
+            std::scoped_lock run_lock{ run_mutex_ };
+            {
+                std::scoped_lock lock{ mutex_ };
+                task_ = &task;
+                next_task_ = 0;
+                task_count_ = task_count;
+                tasks_remaining_ = task_count;
+            }
+
+            work_ready_.notify_all();
+            std::unique_lock lock{ mutex_ };
+            run_tasks(lock);
+            work_done_.wait(lock, [this] { return tasks_remaining_ == 0; });
+            task_ = nullptr;
+            if (error_)
+            {
+                std::rethrow_exception(std::exchange(error_, nullptr));
+            }
+        }
+
+    private:
+        auto work() -> void
+        {
+            std::unique_lock lock{ mutex_ };
+            while (true)
+            {
+                work_ready_.wait(lock, [this] { return stopping_ || next_task_ < task_count_; });
+                if (stopping_)
+                {
+                    return;
+                }
+
+                run_tasks(lock);
+            }
+        }
+
+        /**
+         * Take and run tasks until none are left to take. The first task to
+         * throw stops the rest from being taken.
+         */
+        auto run_tasks(std::unique_lock<std::mutex>& lock) -> void
+        {
+            while (next_task_ < task_count_)
+            {
+                auto const index{ next_task_++ };
+                auto const& task{ *task_ };
+                lock.unlock();
+                std::exception_ptr error{};
+                running_task_ = true;
+                try
+                {
+                    task(index);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+
+                running_task_ = false;
+                lock.lock();
+                if (error && !error_)
+                {
+                    error_ = std::move(error);
+                    tasks_remaining_ -= task_count_ - next_task_;
+                    next_task_ = task_count_;
+                }
+
+                if (--tasks_remaining_ == 0)
+                {
+                    work_done_.notify_all();
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <sph/hash_format.h>
+#include <sph/ranges/views/detail/text_encoding.h>
+#include <sodium/utils.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * The digest bytes of a hash as written, and the digest size.
+     */
+    struct hash_bytes
+    {
+        std::vector<uint8_t> bytes;
+        size_t target_hash_size;
+        bool valid_padding;
+    };
+
+    /**
+     * Get the unpadded length of a padded hash or just the length from an unpadded hash.
+     * @tparam F The hash format.
+     * @param maybe_padded_hash the hash to check.
+     * @return the unpadded length of the hash.
+     */
+    template<sph::hash_format F>
+    auto maybe_unpadded_length(std::vector<uint8_t> const& maybe_padded_hash) -> std::pair<size_t, bool>
+    {
+        if constexpr (F == sph::hash_format::raw)
+        {
+            return { maybe_padded_hash.size(), true };
+        }
+        else
+        {
+            size_t current{ maybe_padded_hash.size() };
+            while (current > 0 && maybe_padded_hash[current - 1] == 0x00)
+            {
+                --current;
+            }
+
+            if (current == 0 || maybe_padded_hash[current - 1] != 0x80)
+            {
+                return { 0, false };
+            }
+
+            return { current - 1, true };
+        }
+    }
+
+    /**
+     * Get the digest bytes and size from a hash as written: decoded from
+     * text, or with any padding found. A hash that isn't validly
+     * encoded or padded is marked invalid.
+     * @tparam F The hash format.
+     */
+    template<sph::hash_format F>
+    auto to_hash_bytes(std::vector<uint8_t> bytes) -> hash_bytes
+    {
+        if constexpr (is_text_format(F))
+        {
+            auto decoded{ decode_text<F>(bytes) };
+            if (!decoded)
+            {
+                return { {}, 0, false };
+            }
+
+            auto const size{ decoded->size() };
+            return { std::move(*decoded), size, true };
+        }
+        else
+        {
+            auto [target_hash_size, valid_padding]{ maybe_unpadded_length<F>(bytes) };
+            return { std::move(bytes), target_hash_size, valid_padding };
+        }
+    }
+
+    /**
+     * Compare the first count bytes of two digests in constant time.
+     *
+     * Keyed algorithms (Poly1305, SipHash, keyed BLAKE2b) verify
+     * authentication tags, so the comparison must not stop at the first
+     * mismatched byte.
+     */
+    inline auto digests_equal(std::vector<uint8_t> const& lhs, std::vector<uint8_t> const& rhs, size_t count) -> bool
+    {
+        if (lhs.size() < count || rhs.size() < count)
+        {
+            return false;
+        }
+
+        return count == 0 || sodium_memcmp(lhs.data(), rhs.data(), count) == 0;
+    }
+}
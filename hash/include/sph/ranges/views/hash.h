@@ -1,10 +1,24 @@
 #pragma once
+#include <format>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 #include <sph/blake2b_parameters.h>
+#include <sph/blake2s_parameters.h>
+#include <sph/digest.h>
+#include <sph/git_object_parameters.h>
 #include <sph/hash_algorithm.h>
 #include <sph/hash_format.h>
 #include <sph/hash_site.h>
+#include <sph/interleave_parameters.h>
+#include <sph/k12_parameters.h>
+#include <sph/parallel_hash_parameters.h>
+#include <sph/poly1305_parameters.h>
+#include <sph/siphash_parameters.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/batch_hasher.h>
 #include <sph/ranges/views/detail/hash_util.h>
+#include <sph/ranges/views/detail/hash_interleave.h>
 #include <sph/ranges/views/detail/hash_iterator.h>
 #include <sph/ranges/views/detail/get_hash_size.h>
 
@@ -20,7 +34,7 @@ namespace sph::ranges::views
          * @tparam R The type of the range that holds a hashed stream.
          * @tparam T The output type.
          * @tparam A The hash algorithm to use.
-         * @tparam F The hash format to use (padded or raw).
+         * @tparam F The hash format to use (padded, raw, or text).
          * @tparam S The hash style to use (append to hashed data or separate from hashed data).
          */
         template<hash_range R, typename T, sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
@@ -33,6 +47,7 @@ namespace sph::ranges::views
             R input_;  // store the original range
             size_t target_hash_size_;
             algorithm_parameters_t algorithm_parameters_{};
+            std::span<uint8_t> digest_sink_{};
             using iterator = hash_iterator<R, T, A, F, S, end_of_input::no_appended_hash>;
             using sentinel = hash_sentinel<R, T, A, F, S, end_of_input::no_appended_hash>;
 
@@ -46,15 +61,21 @@ namespace sph::ranges::views
              * @param target_hash_size Hash will be this size for single byte
              * output; it may extend to fill multibyte output.
              * @param input the range to hash.
+             * @param digest_sink where to copy the digest, if anywhere, each
+             * time the hash is finalized.
              */
-            explicit hash_view(size_t target_hash_size, R&& input)
-                : input_(std::move(input)), target_hash_size_{ detail::get_hash_size<A>(target_hash_size) } {}
+            explicit hash_view(size_t target_hash_size, R&& input, std::span<uint8_t> digest_sink = {})
+                : input_(std::move(input))
+                , target_hash_size_{ detail::get_hash_size<A, F, S>(target_hash_size) }
+                , digest_sink_{ digest_sink }
+            {}
 
-            hash_view(size_t target_hash_size, R&& input, algorithm_parameters_t algorithm_parameters)
-                requires (A == sph::hash_algorithm::blake2b)
+            hash_view(size_t target_hash_size, R&& input, algorithm_parameters_t algorithm_parameters, std::span<uint8_t> digest_sink = {})
+                requires sph::ranges::views::detail::has_algorithm_parameters<A>
                 : input_(std::move(input))
-                , target_hash_size_{ detail::get_hash_size<A>(target_hash_size) }
+                , target_hash_size_{ detail::get_hash_size<A, F, S>(target_hash_size) }
                 , algorithm_parameters_{ algorithm_parameters }
+                , digest_sink_{ digest_sink }
             {}
 
             hash_view(hash_view const&) = default;
@@ -66,13 +87,14 @@ namespace sph::ranges::views
             auto begin() const -> iterator
             {
                 // Use the stored view's iterators directly.
-                if constexpr (A == sph::hash_algorithm::blake2b)
+                if constexpr (sph::ranges::views::detail::has_algorithm_parameters<A>)
                 {
                     return iterator(
                         std::ranges::begin(input_),
                         std::ranges::end(input_),
                         target_hash_size_,
-                        algorithm_parameters_
+                        algorithm_parameters_,
+                        digest_sink_
                     );
                 }
                 else
@@ -80,7 +102,8 @@ namespace sph::ranges::views
                     return iterator(
                         std::ranges::begin(input_),
                         std::ranges::end(input_),
-                        target_hash_size_
+                        target_hash_size_,
+                        digest_sink_
                     );
                 }
             }
@@ -104,11 +127,106 @@ namespace sph::ranges::views
         {
             size_t target_hash_size_;
             sph::ranges::views::detail::algorithm_parameters_t<A> algorithm_parameters_{};
+            std::span<uint8_t> digest_sink_{};
+            sph::interleave_parameters interleave_parameters_{};
         public:
             explicit hash_fn(size_t target_hash_size) noexcept : target_hash_size_{ target_hash_size } {}
 
+            /**
+             * Gets a copy of this functor whose views also copy the digest
+             * into digest_sink when the hash is finalized, so one pass gives
+             * both the appended stream and the digest to store. The digest is
+             * the raw hash, before any padding or text encoding.
+             *
+             * @param digest_sink Where to copy the digest; exactly the
+             *      target hash size, or std::invalid_argument. It must
+             *      outlive iteration of the views.
+             */
+            [[nodiscard]] auto with_digest_sink(std::span<uint8_t> digest_sink) const -> hash_fn
+                requires (S == sph::hash_site::append)
+            {
+                if (auto const hash_size{ get_hash_size<A, F, S>(target_hash_size_) }; digest_sink.size() != hash_size)
+                {
+                    throw std::invalid_argument(std::format("Digest sink of {} bytes doesn't match the {} byte hash.", digest_sink.size(), hash_size));
+                }
+
+                auto result{ *this };
+                result.digest_sink_ = digest_sink;
+                return result;
+            }
+
+            template<size_t N>
+            [[nodiscard]] auto with_digest_sink(sph::digest<A, N>& digest_sink) const -> hash_fn
+                requires (S == sph::hash_site::append)
+            {
+                return with_digest_sink(std::span<uint8_t>{ digest_sink.bytes() });
+            }
+
+            /**
+             * Gets a copy of this functor whose interleaved views hash blocks
+             * of the given size, chained or not.
+             *
+             * @param parameters The block size, a whole number of output
+             *      elements, or std::invalid_argument, and whether each
+             *      block's hash covers the one before it.
+             */
+            [[nodiscard]] auto with_interleave_parameters(sph::interleave_parameters parameters) const -> hash_fn
+                requires (S == sph::hash_site::interleave)
+            {
+                check_interleave_layout<F, T>(parameters, get_hash_size<A, F, S>(target_hash_size_));
+                auto result{ *this };
+                result.interleave_parameters_ = parameters;
+                return result;
+            }
+
             [[nodiscard]] auto with_blake2b_parameters(sph::blake2b_parameters parameters) const -> hash_fn
-                requires (A == sph::hash_algorithm::blake2b)
+                requires (A == sph::hash_algorithm::blake2b || A == sph::hash_algorithm::blake2bp)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_blake2s_parameters(sph::blake2s_parameters parameters) const -> hash_fn
+                requires (A == sph::hash_algorithm::blake2s || A == sph::hash_algorithm::blake2sp)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_siphash_parameters(sph::siphash_parameters parameters) const -> hash_fn
+                requires (A == sph::hash_algorithm::siphash24 || A == sph::hash_algorithm::siphashx24)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_poly1305_parameters(sph::poly1305_parameters parameters) const -> hash_fn
+                requires (A == sph::hash_algorithm::poly1305)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_k12_parameters(sph::k12_parameters parameters) const -> hash_fn
+                requires (A == sph::hash_algorithm::k12)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_parallel_hash_parameters(sph::parallel_hash_parameters parameters) const -> hash_fn
+                requires (A == sph::hash_algorithm::parallelhash128 || A == sph::hash_algorithm::parallelhash256)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_git_object_parameters(sph::git_object_parameters parameters) const -> hash_fn
+                requires (A == sph::hash_algorithm::git_sha1 || A == sph::hash_algorithm::git_sha256)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            /**
+             * Gets a copy of this functor that hashes with the given
+             * algorithm-specific parameters (key, salt, etc.).
+             */
+            [[nodiscard]] auto with_algorithm_parameters(sph::ranges::views::detail::algorithm_parameters_t<A> parameters) const -> hash_fn
+                requires sph::ranges::views::detail::has_algorithm_parameters<A>
             {
                 auto result{ *this };
                 result.algorithm_parameters_ = parameters;
@@ -117,21 +235,28 @@ namespace sph::ranges::views
 
             template <sph::ranges::views::detail::hash_range R>
             [[nodiscard]] constexpr auto operator()(R&& range) const -> hash_view<std::views::all_t<R>, T, A, F, S>
-                requires (sph::ranges::views::detail::copyable_or_borrowed<R> || S == sph::hash_site::separate)
+                requires ((sph::ranges::views::detail::copyable_or_borrowed<R> || S == sph::hash_site::separate) && S != sph::hash_site::interleave)
             {
-                if constexpr (A == sph::hash_algorithm::blake2b)
+                if constexpr (sph::ranges::views::detail::has_algorithm_parameters<A>)
                 {
-                    return hash_view<std::views::all_t<R>, T, A, F, S>(target_hash_size_, std::views::all(std::forward<R>(range)), algorithm_parameters_);
+                    return hash_view<std::views::all_t<R>, T, A, F, S>(target_hash_size_, std::views::all(std::forward<R>(range)), algorithm_parameters_, digest_sink_);
                 }
                 else
                 {
-                    return hash_view<std::views::all_t<R>, T, A, F, S>(target_hash_size_, std::views::all(std::forward<R>(range)));
+                    return hash_view<std::views::all_t<R>, T, A, F, S>(target_hash_size_, std::views::all(std::forward<R>(range)), digest_sink_);
                 }
             }
 
+            template <sph::ranges::views::detail::hash_range R>
+            [[nodiscard]] constexpr auto operator()(R&& range) const -> hash_interleave_view<std::views::all_t<R>, T, A, F>
+                requires (S == sph::hash_site::interleave)
+            {
+                return { target_hash_size_, std::views::all(std::forward<R>(range)), interleave_parameters_, algorithm_parameters_ };
+            }
+
             template <sph::ranges::views::detail::hash_range R>
             [[nodiscard]] constexpr auto operator()(R&&) const -> std::array<T, 0>
-                requires (!sph::ranges::views::detail::copyable_or_borrowed<R> && S == sph::hash_site::append)
+                requires (!sph::ranges::views::detail::copyable_or_borrowed<R> && S != sph::hash_site::separate && S != sph::hash_site::interleave)
             {
                 // Here, a copy could be made and, maybe, if a low-cost method
                 // exists, that should get done here.
@@ -145,6 +270,86 @@ namespace sph::ranges::views
 
             }
         };
+
+        /**
+         * Functor that, given a range, hashes it into an N-byte digest.
+         *
+         * The size is checked against the algorithm at compile time and the
+         * digest is a fixed-extent range, so nothing downstream branches on
+         * a run-time hash size.
+         * @tparam A The hash algorithm to use.
+         * @tparam N The digest size in bytes.
+         */
+        template <sph::hash_algorithm A, size_t N>
+        class fixed_hash_fn : public std::ranges::range_adaptor_closure<fixed_hash_fn<A, N>>
+        {
+            static_assert(N > 0, "A fixed hash size must be at least one byte.");
+            static_assert(N <= sph::hash_param<A>::hash_byte_count() || sph::hash_param<A>::extendable_output(),
+                "The fixed hash size is larger than the algorithm's hash size.");
+            sph::ranges::views::detail::algorithm_parameters_t<A> algorithm_parameters_{};
+        public:
+            [[nodiscard]] auto with_blake2b_parameters(sph::blake2b_parameters parameters) const -> fixed_hash_fn
+                requires (A == sph::hash_algorithm::blake2b || A == sph::hash_algorithm::blake2bp)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_blake2s_parameters(sph::blake2s_parameters parameters) const -> fixed_hash_fn
+                requires (A == sph::hash_algorithm::blake2s || A == sph::hash_algorithm::blake2sp)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_siphash_parameters(sph::siphash_parameters parameters) const -> fixed_hash_fn
+                requires (A == sph::hash_algorithm::siphash24 || A == sph::hash_algorithm::siphashx24)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_poly1305_parameters(sph::poly1305_parameters parameters) const -> fixed_hash_fn
+                requires (A == sph::hash_algorithm::poly1305)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_k12_parameters(sph::k12_parameters parameters) const -> fixed_hash_fn
+                requires (A == sph::hash_algorithm::k12)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_parallel_hash_parameters(sph::parallel_hash_parameters parameters) const -> fixed_hash_fn
+                requires (A == sph::hash_algorithm::parallelhash128 || A == sph::hash_algorithm::parallelhash256)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            [[nodiscard]] auto with_git_object_parameters(sph::git_object_parameters parameters) const -> fixed_hash_fn
+                requires (A == sph::hash_algorithm::git_sha1 || A == sph::hash_algorithm::git_sha256)
+            {
+                return with_algorithm_parameters(parameters);
+            }
+
+            /**
+             * Gets a copy of this functor that hashes with the given
+             * algorithm-specific parameters (key, salt, etc.).
+             */
+            [[nodiscard]] auto with_algorithm_parameters(sph::ranges::views::detail::algorithm_parameters_t<A> parameters) const -> fixed_hash_fn
+                requires sph::ranges::views::detail::has_algorithm_parameters<A>
+            {
+                auto result{ *this };
+                result.algorithm_parameters_ = parameters;
+                return result;
+            }
+
+            template <sph::ranges::views::detail::hash_range R>
+            [[nodiscard]] auto operator()(R&& range) const -> sph::digest<A, N>
+            {
+                sph::digest<A, N> ret;
+                batch_hasher<A>{ N, algorithm_parameters_ }.hash(std::forward<R>(range), ret.bytes());
+                return ret;
+            }
+        };
     }
 }
 
@@ -155,7 +360,7 @@ namespace sph::ranges::views
  * @tparam R The type of the range that holds a hashed stream.
  * @tparam T The output type.
  * @tparam A The hash algorithm to use.
- * @tparam F The hash format to use (padded or raw).
+ * @tparam F The hash format to use (padded, raw, or text).
  * @tparam S The hash style to use (append to hashed data or separate from hashed data).
  */
 template <sph::ranges::views::detail::hash_range R, typename T, sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
@@ -174,15 +379,26 @@ namespace sph::views
      * @tparam A The hash algorithm to use. Either hash_algorithm::sha256,
      *      hash_algorithm::sha512, or hash_algorithm::blake2b.
      * @tparam T The output type. Must be sph::ranges::views::detail::hashable_type<T>.
-     * @tparam F The hash format to use. Either raw or padded.
-     * @tparam S The hash site to use. Either hash_site::append or
-     *      hash_site::separate. Defaults to separate. With append, the input
-     *      range gets passed to the output view with the hash immediately
-     *      following.
-     * @param target_hash_size The size in bytes of the hash to create.
+     * @tparam F The hash format to use. Either raw, padded, or a text
+     *      format: hex, hex_upper, or base64url (unpadded). A text hash is
+     *      encoded when it is finalized and read out a character at a time,
+     *      so <code>| std::ranges::to<std::string>()</code> gives the text.
+     * @tparam S The hash site to use. Either hash_site::append,
+     *      hash_site::prepend, hash_site::interleave, or
+     *      hash_site::separate. Defaults to separate.
+     *      With append, the input range gets passed to the output view with
+     *      the hash immediately following. With prepend, the hash comes
+     *      first and the input follows it; the input, a forward range, is
+     *      read once to hash it and again to output it. With interleave, a
+     *      hash follows every block of the input; see
+     *      <code>with_interleave_parameters()</code>.
+     * @param target_hash_size The size in bytes of the hash to create,
+     *      before any text encoding.
      *      <code>0 <= target_hash_size <= sph::hash_param<A>::hash_byte_count()</code>
      *      or <code>std::invalid_argument</code>; if 0,
-     *      <code>...hash_byte_count()</code> is used.
+     *      <code>...hash_byte_count()</code> is used. Algorithms with
+     *      <code>sph::hash_param<A>::extendable_output()</code> have no upper
+     *      bound when the hash is raw and separate.
      * @return a functor that takes a range and returns a hashed view of that range.
      */
     template<sph::hash_algorithm A, typename T, sph::hash_format F, sph::hash_site S>
@@ -703,6 +919,26 @@ namespace sph::views
     }
 
 
+    // fixed size: hash<A, N>() gives an N-byte sph::digest<A, N>
+
+    /**
+     * A range adaptor that hashes a range into an N-byte digest, with N
+     * checked against the algorithm at compile time.
+     *
+     * The result is a <code>sph::digest<A, N></code> rather than a lazy
+     * view: a fixed-extent range whose <code>bytes()</code> is a
+     * <code>std::span<uint8_t const, N></code>.
+     *
+     * @tparam A The hash algorithm to use.
+     * @tparam N The size in bytes of the hash to create.
+     * @return a functor that takes a range and returns its digest.
+     */
+    template<sph::hash_algorithm A, size_t N>
+    auto hash() -> sph::ranges::views::detail::fixed_hash_fn<A, N>
+    {
+        return sph::ranges::views::detail::fixed_hash_fn<A, N>{};
+    }
+
     // default: separate raw uint8_t blake2b hash
 
     inline auto hash(size_t target_hash_size = 0) -> sph::ranges::views::detail::hash_fn<uint8_t, sph::hash_algorithm::blake2b, sph::hash_format::raw, sph::hash_site::separate>
@@ -10,12 +10,25 @@
 #include <utility>
 #include <vector>
 #include <sph/blake2b_parameters.h>
+#include <sph/blake2s_parameters.h>
+#include <sph/digest.h>
 #include <sph/hash_algorithm.h>
 #include <sph/hash_site.h>
 #include <sph/hash_format.h>
+#include <sph/git_object_parameters.h>
+#include <sph/k12_parameters.h>
+#include <sph/parallel_hash_parameters.h>
+#include <sph/poly1305_parameters.h>
+#include <sph/siphash_parameters.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/batch_hasher.h>
 #include <sph/ranges/views/detail/hash_util.h>
 #include <sph/ranges/views/detail/single_bool_iterator.h>
+#include <sph/ranges/views/detail/text_encoding.h>
+#include <sph/ranges/views/detail/verify_util.h>
 #include <sph/ranges/views/hash.h>
+#include <sph/ranges/views/hash_verify_payload.h>
+#include <sodium/utils.h>
 
 namespace sph::ranges::views::detail
 {
@@ -51,16 +64,16 @@ namespace sph::ranges::views::detail
      * @tparam F The hash format enum value.
      */
     template <sph::hash_format F>
-    using hash_verify_format_t = 
-    std::conditional_t<F == sph::hash_format::padded, sph::ranges::views::detail::hash_verify_format_padded, sph::ranges::views::detail::hash_verify_format_raw>;
+    using hash_verify_format_t = std::integral_constant<sph::hash_format, F>;
 
 
     /**
-     * A hash_verify_format_padded, hash_verify_format_raw or std::nullopt_t.
+     * A hash_verify_format_t (e.g. hash_verify_format_padded or
+     * hash_verify_format_raw) or std::nullopt_t.
      * @tparam F the type of the hash format.
      */
     template <typename F>
-    concept hash_verify_fn_hash_format = std::is_same_v<F, sph::ranges::views::detail::hash_verify_format_padded> || std::is_same_v<F, sph::ranges::views::detail::hash_verify_format_raw> || std::is_same_v<F, std::nullopt_t>;
+    concept hash_verify_fn_hash_format = std::is_same_v<F, std::nullopt_t> || std::is_same_v<F, hash_verify_format_t<F::value>>;
 
     /**
      * Get the hash_format value from the hash_verify_fn_hash_format type.
@@ -156,28 +169,38 @@ namespace sph::ranges::views::detail
         
     /**
          * Provides view of hash of the input range.
+         *
+         * Nothing is hashed until the first begin(), which verifies the
+         * input and keeps the result for later calls. Building the view is
+         * cheap, so a pipeline that is dropped, or never reached because an
+         * earlier check failed, costs no hashing. The input must still hold
+         * the data to verify at that first begin(). Like std::views::filter,
+         * which caches its first begin() too, the view has no const begin(),
+         * so a view shared between threads must not be read by them at
+         * once.
+         *
          * @tparam R The type of the range that holds a hashed stream.
          * @tparam T The type of the hash output range elements.
          * @tparam A The type of the hash to do.
-         * @tparam F The format of the hash (padded or raw).
+         * @tparam F The format of the hash (padded, raw, or text).
+         * @tparam S Where the hash is: appended or prepended to the input, or
+         * separate.
          */
-    template<hash_range R, hashable_type T, sph::hash_algorithm A, sph::hash_format F>
-    class hash_verify_view : public std::ranges::view_interface<hash_verify_view<R, T, A, F>>
+    template<hash_range R, hashable_type T, sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
+    class hash_verify_view : public std::ranges::view_interface<hash_verify_view<R, T, A, F, S>>
     {
-        bool verify_ok_{ false };
-
         using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
-        using input_type = std::remove_cvref_t<std::ranges::range_value_t<R>>;
-        using input_append_iterator = detail::hash_iterator<R, input_type, A, F, sph::hash_site::append, end_of_input::skip_appended_hash>;
-        using input_append_sentinel = detail::hash_sentinel<R, input_type, A, F, sph::hash_site::append, end_of_input::skip_appended_hash>;
+        using input_payload_iterator = hash_verify_payload_iterator<R, A, F, S>;
         using input_separate_iterator = detail::hash_iterator<R, T, A, F, sph::hash_site::separate, end_of_input::no_appended_hash>;
         using input_separate_sentinel = detail::hash_sentinel<R, T, A, F, sph::hash_site::separate, end_of_input::no_appended_hash>;
-        struct hash_bytes
-        {
-            std::vector<uint8_t> bytes;
-            size_t target_hash_size;
-            bool valid_padding;
-        };
+        // a separate hash is read up front, which is cheap; the input isn't
+        using provided_hash_t = std::conditional_t<S == sph::hash_site::separate, hash_bytes, hash_verify_empty>;
+
+        R input_;
+        [[no_unique_address]] provided_hash_t provided_hash_{};
+        size_t target_hash_size_{ 0 };
+        algorithm_parameters_t algorithm_parameters_{};
+        std::optional<bool> verify_ok_{};
     public:
         using iterator = single_bool_iterator;
         using sentinel = single_bool_sentinel;
@@ -193,14 +216,18 @@ namespace sph::ranges::views::detail
          * @param hash the hash to compare against.
          */
         template<hash_range H>
-        hash_verify_view(R&& input, H&& hash)  // NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
-            : verify_ok_{verify(std::forward<R>(input), std::forward<H>(hash))}
+        hash_verify_view(R&& input, H&& hash)
+            requires (S == sph::hash_site::separate)
+            : input_{ std::move(input) }
+            , provided_hash_{ hash_to_byte_vector(std::forward<H>(hash)) }
         {}
 
         template<hash_range H>
-        hash_verify_view(R&& input, H&& hash, algorithm_parameters_t algorithm_parameters)  // NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
-            requires (A == sph::hash_algorithm::blake2b)
-            : verify_ok_{verify(std::forward<R>(input), std::forward<H>(hash), algorithm_parameters)}
+        hash_verify_view(R&& input, H&& hash, algorithm_parameters_t algorithm_parameters)
+            requires (has_algorithm_parameters<A> && S == sph::hash_site::separate)
+            : input_{ std::move(input) }
+            , provided_hash_{ hash_to_byte_vector(std::forward<H>(hash)) }
+            , algorithm_parameters_{ algorithm_parameters }
         {}
 
         /**
@@ -209,18 +236,22 @@ namespace sph::ranges::views::detail
          * Provides a begin() iterator and end() sentinel over the
          * verified view of the given input range.
          *
-         * The hash is appended to the input range.
+         * The hash is appended or prepended to the input range.
          *
          * @param target_hash_size the size (in bytes) of the hash.
          * @param input the range to verify.
          */
-        hash_verify_view(size_t target_hash_size, R&& input)  // NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
-            : verify_ok_ { verify(target_hash_size, std::forward<R>(input)) }
+        hash_verify_view(size_t target_hash_size, R&& input)
+            requires (S != sph::hash_site::separate)
+            : input_{ std::move(input) }
+            , target_hash_size_{ get_hash_size<A, F, S>(target_hash_size) }
         {}
 
-        hash_verify_view(size_t target_hash_size, R&& input, algorithm_parameters_t algorithm_parameters)  // NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
-            requires (A == sph::hash_algorithm::blake2b)
-            : verify_ok_ { verify(target_hash_size, std::forward<R>(input), algorithm_parameters) }
+        hash_verify_view(size_t target_hash_size, R&& input, algorithm_parameters_t algorithm_parameters)
+            requires (has_algorithm_parameters<A> && S != sph::hash_site::separate)
+            : input_{ std::move(input) }
+            , target_hash_size_{ get_hash_size<A, F, S>(target_hash_size) }
+            , algorithm_parameters_{ algorithm_parameters }
         {}
 
         hash_verify_view(hash_verify_view const&) = default;
@@ -231,39 +262,21 @@ namespace sph::ranges::views::detail
         auto operator=(hash_verify_view&&o) noexcept -> hash_verify_view& = default;
 
 
-        [[nodiscard]] auto begin() -> iterator { return iterator(verify_ok_); }
-        [[nodiscard]] auto begin() const -> iterator { return iterator(verify_ok_); }
+        [[nodiscard]] auto begin() -> iterator { return iterator(verified()); }
 
-        [[nodiscard]] auto end() -> sentinel { return sentinel{}; }
         [[nodiscard]] auto end() const -> sentinel { return sentinel{}; }
     private:
-
         /**
-         * Get the unpadded length of a padded hash or just the length from an unpadded hash.
-         * @param maybe_padded_hash the hash to check.
-         * @return the unpadded length of the hash.
+         * Verify the input the first time through; after that, the result.
          */
-        static auto maybe_unpadded_length(std::vector<uint8_t> const& maybe_padded_hash) -> std::pair<size_t, bool>
+        auto verified() -> bool
         {
-            if constexpr (F == sph::hash_format::raw)
+            if (!verify_ok_)
             {
-                return { maybe_padded_hash.size(), true };
+                verify_ok_ = verify();
             }
-            else
-            {
-                size_t current{ maybe_padded_hash.size() };
-                while (current > 0 && maybe_padded_hash[current - 1] == 0x00)
-                {
-                    --current;
-                }
 
-                if (current == 0 || maybe_padded_hash[current - 1] != 0x80)
-                {
-                    return { 0, false };
-                }
-
-                return { current - 1, true };
-            }
+            return *verify_ok_;
         }
 
         /**
@@ -279,8 +292,7 @@ namespace sph::ranges::views::detail
                     return static_cast<uint8_t>(v);
                 })
                 | std::ranges::to<std::vector>()};
-            auto [target_hash_size, valid_padding]{ maybe_unpadded_length(ret) };
-            return { std::move(ret), target_hash_size, valid_padding };
+            return to_hash_bytes<F>(std::move(ret));
         }
 
         template<hash_verify_multi_byte_range H>
@@ -296,43 +308,37 @@ namespace sph::ranges::views::detail
                 })
                 | std::views::join
                 | std::ranges::to<std::vector>()};
-            auto [target_hash_size, valid_padding]{ maybe_unpadded_length(ret) };
-            return { std::move(ret), target_hash_size, valid_padding };
+            return to_hash_bytes<F>(std::move(ret));
         }
 
-        template<hash_range H>
-        static auto verify(R&& input, H&& hash) -> bool
-        {
-            return verify(std::forward<R>(input), std::forward<H>(hash), algorithm_parameters_t{});
-        }
-
-        template<hash_range H>
-        static auto verify(R&& input, H&& hash, algorithm_parameters_t algorithm_parameters) -> bool
+        /**
+         * Verify the input against the separate hash.
+         */
+        auto verify() const -> bool
+            requires (S == sph::hash_site::separate)
         {
-            auto provided_hash_data{ hash_to_byte_vector(std::forward<H>(hash)) };
-            auto const& provided_hash{ provided_hash_data.bytes };
-            auto const target_hash_size{ provided_hash_data.target_hash_size };
-            if (!provided_hash_data.valid_padding)
+            auto const& provided_hash{ provided_hash_.bytes };
+            auto const target_hash_size{ provided_hash_.target_hash_size };
+            if (!provided_hash_.valid_padding)
             {
                 return false;
             }
 
-            R to_hash{ std::move(input) };
             auto hash_result_data{
                 [&]() -> hash_bytes
                 {
-                    if constexpr (A == sph::hash_algorithm::blake2b)
+                    if constexpr (has_algorithm_parameters<A>)
                     {
                         return hash_to_byte_vector(
                             std::ranges::subrange(
-                                input_separate_iterator(std::ranges::begin(to_hash), std::ranges::end(to_hash), target_hash_size, algorithm_parameters),
+                                input_separate_iterator(std::ranges::begin(input_), std::ranges::end(input_), target_hash_size, algorithm_parameters_),
                                 input_separate_sentinel{}));
                     }
                     else
                     {
                         return hash_to_byte_vector(
                             std::ranges::subrange(
-                                input_separate_iterator(std::ranges::begin(to_hash), std::ranges::end(to_hash), target_hash_size),
+                                input_separate_iterator(std::ranges::begin(input_), std::ranges::end(input_), target_hash_size),
                                 input_separate_sentinel{}));
                     }
                 }()
@@ -354,86 +360,36 @@ namespace sph::ranges::views::detail
                 return false;
             }
 
-            return { std::ranges::all_of(std::views::zip(provided_hash | std::views::take(target_hash_size), hash_result | std::views::take(target_hash_size)), [](auto&& pair)
-            {
-                return std::get<0>(pair) == std::get<1>(pair);
-            })};
-        }
-
-        static auto verify(size_t target_hash_size, R&& input) -> bool
-        {
-            return verify(target_hash_size, std::forward<R>(input), algorithm_parameters_t{});
+            return digests_equal(provided_hash, hash_result, target_hash_size);
         }
 
-        static auto verify(size_t target_hash_size, R&& input, algorithm_parameters_t algorithm_parameters) -> bool
+        /**
+         * Verify a hash appended or prepended to the input by reading its
+         * payload to the end; the payload is hashed as it is read, not kept.
+         */
+        auto verify() const -> bool
+            requires (S != sph::hash_site::separate)
         {
-            R to_hash{ std::move(input) };
-            auto hasher {
-                [&]() -> input_append_iterator
+            bool verified{ false };
+            auto payload {
+                [&]() -> input_payload_iterator
                 {
-                    if constexpr (A == sph::hash_algorithm::blake2b)
+                    if constexpr (has_algorithm_parameters<A>)
                     {
-                        return input_append_iterator(std::ranges::begin(to_hash), std::ranges::end(to_hash), target_hash_size, algorithm_parameters);
+                        return { std::ranges::begin(input_), std::ranges::end(input_), target_hash_size_, &verified, algorithm_parameters_ };
                     }
                     else
                     {
-                        return input_append_iterator(std::ranges::begin(to_hash), std::ranges::end(to_hash), target_hash_size);
+                        return { std::ranges::begin(input_), std::ranges::end(input_), target_hash_size_, &verified };
                     }
                 }()
             };
-            std::vector<input_type> unhashed_input{};
-            for (; hasher != input_append_sentinel{}; ++hasher)
+            while (payload != std::default_sentinel)
             {
-                unhashed_input.push_back(*hasher);
+                ++payload;
             }
 
-            auto appended_hash_data{ hash_to_byte_vector(hasher.appended_hash()) };
-            auto const& appended_hash{ appended_hash_data.bytes };
-            auto const appended_hash_size{ appended_hash_data.target_hash_size };
-            if (!appended_hash_data.valid_padding)
-            {
-                return false;
-            }
-
-            auto hash_result_data{
-                [&]() -> hash_bytes
-                {
-                    if constexpr (A == sph::hash_algorithm::blake2b)
-                    {
-                        auto hash_fn{
-                            sph::views::hash<A, uint8_t, F>(target_hash_size)
-                            .with_blake2b_parameters(algorithm_parameters)
-                        };
-                        return hash_to_byte_vector(unhashed_input | hash_fn);
-                    }
-                    else
-                    {
-                        return hash_to_byte_vector(unhashed_input | sph::views::hash<A, uint8_t, F>(target_hash_size));
-                    }
-                }()
-            };
-            auto const& hash_result{ hash_result_data.bytes };
-            auto const hash_result_size{ hash_result_data.target_hash_size };
-            if (!hash_result_data.valid_padding)
-            {
-                return false;
-            }
-
-            if (appended_hash_size != hash_result_size)
-            {
-                return false;
-            }
-
-            bool const ret{
-                std::ranges::all_of(
-                    std::views::zip(
-                        appended_hash | std::views::take(appended_hash_size),
-                        hash_result | std::views::take(hash_result_size)),
-                    [](auto&& pair)
-            {
-                return std::get<0>(pair) == std::get<1>(pair);
-            }) };
-            return ret;
+            return verified;
         }
     };
 
@@ -446,15 +402,20 @@ namespace sph::ranges::views::detail
      * if the hash verified correctly or not.
      * @tparam A The hash algorithm.
      * @tparam H The hash data range type to verify against.
+     * @tparam S Where a hash that isn't separate is: appended or prepended.
      */
-    template <sph::hash_algorithm A, hash_verify_fn_hash_format F, hash_verify_fn_hash_range H>
-    class hash_verify_fn : public std::ranges::range_adaptor_closure<hash_verify_fn<A, F, H>>
+    template <sph::hash_algorithm A, hash_verify_fn_hash_format F, hash_verify_fn_hash_range H, sph::hash_site S = sph::hash_site::append>
+    class hash_verify_fn : public std::ranges::range_adaptor_closure<hash_verify_fn<A, F, H, S>>
     {
         static constexpr bool appended_hash{ std::is_same_v<H, std::nullopt_t> };
+        static constexpr hash_site hs{ appended_hash ? S : sph::hash_site::separate };
         using hash_t = std::conditional_t<appended_hash, hash_verify_empty, H>;
         using target_hash_size_t = std::conditional_t<appended_hash, size_t, hash_verify_empty>;
         using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
-        static constexpr hash_format hf{ hash_verify_format<F, hash_t>::value };
+        // without a format, an appended hash takes its format from the
+        // input's elements, a separate one from the hash's
+        template <typename R>
+        static constexpr hash_format hf{ hash_verify_format<F, std::conditional_t<appended_hash, R, hash_t>>::value };
         static constexpr hash_algorithm ha{ A };
         hash_t hash_;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
         target_hash_size_t  target_hash_size_;
@@ -467,7 +428,53 @@ namespace sph::ranges::views::detail
             : hash_{std::forward<H>(hash)} {}
 
         [[nodiscard]] auto with_blake2b_parameters(sph::blake2b_parameters parameters) const -> hash_verify_fn
-            requires (A == sph::hash_algorithm::blake2b)
+            requires (A == sph::hash_algorithm::blake2b || A == sph::hash_algorithm::blake2bp)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_blake2s_parameters(sph::blake2s_parameters parameters) const -> hash_verify_fn
+            requires (A == sph::hash_algorithm::blake2s || A == sph::hash_algorithm::blake2sp)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_siphash_parameters(sph::siphash_parameters parameters) const -> hash_verify_fn
+            requires (A == sph::hash_algorithm::siphash24 || A == sph::hash_algorithm::siphashx24)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_poly1305_parameters(sph::poly1305_parameters parameters) const -> hash_verify_fn
+            requires (A == sph::hash_algorithm::poly1305)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_k12_parameters(sph::k12_parameters parameters) const -> hash_verify_fn
+            requires (A == sph::hash_algorithm::k12)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_parallel_hash_parameters(sph::parallel_hash_parameters parameters) const -> hash_verify_fn
+            requires (A == sph::hash_algorithm::parallelhash128 || A == sph::hash_algorithm::parallelhash256)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_git_object_parameters(sph::git_object_parameters parameters) const -> hash_verify_fn
+            requires (A == sph::hash_algorithm::git_sha1 || A == sph::hash_algorithm::git_sha256)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        /**
+         * Gets a copy of this functor that verifies with the given
+         * algorithm-specific parameters (key, salt, etc.).
+         */
+        [[nodiscard]] auto with_algorithm_parameters(algorithm_parameters_t parameters) const -> hash_verify_fn
+            requires has_algorithm_parameters<A>
         {
             auto result{ *this };
             result.algorithm_parameters_ = parameters;
@@ -476,34 +483,34 @@ namespace sph::ranges::views::detail
 
         template <hash_range R>
         [[nodiscard]] constexpr auto operator()(R&& range) const
-            -> hash_verify_view< std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf>
+            -> hash_verify_view< std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf<R>, hs>
             requires (appended_hash)
         {
-            if constexpr (A == sph::hash_algorithm::blake2b)
+            if constexpr (has_algorithm_parameters<A>)
             {
-                return hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf>(
+                return hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf<R>, hs>(
                     target_hash_size_, std::views::all(std::forward<R>(range)), algorithm_parameters_);
             }
             else
             {
-                return hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf>(
+                return hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf<R>, hs>(
                     target_hash_size_, std::views::all(std::forward<R>(range)));
             }
         }
 
         template <hash_range R>
         [[nodiscard]] constexpr auto operator()(R&& range) const
-            -> hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf>
+            -> hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf<R>, hs>
             requires (!appended_hash)
         {
-            if constexpr (A == sph::hash_algorithm::blake2b)
+            if constexpr (has_algorithm_parameters<A>)
             {
-                return hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf>(
+                return hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf<R>, hs>(
                     std::views::all(std::forward<R>(range)), std::views::all(hash_), algorithm_parameters_);
             }
             else
             {
-                return hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf>(
+                return hash_verify_view<std::views::all_t<R>, hash_verify_output<R, hash_t>, ha, hf<R>, hs>(
                     std::views::all(std::forward<R>(range)), std::views::all(hash_));
             }
         }
@@ -524,6 +531,113 @@ namespace sph::ranges::views::detail
         }
     };
 
+    /**
+     * True for sph::digest<A, N> types.
+     */
+    template <typename D>
+    struct is_digest : std::false_type {};
+
+    template <sph::hash_algorithm A, size_t N>
+    struct is_digest<sph::digest<A, N>> : std::true_type {};
+
+    /**
+     * A single-element view of a verification result that was worked out
+     * up front.
+     */
+    class hash_verify_result_view : public std::ranges::view_interface<hash_verify_result_view>
+    {
+        bool verify_ok_{ false };
+    public:
+        using iterator = single_bool_iterator;
+        using sentinel = single_bool_sentinel;
+
+        hash_verify_result_view() = default;
+        explicit hash_verify_result_view(bool verify_ok) : verify_ok_{ verify_ok } {}
+
+        [[nodiscard]] auto begin() const -> iterator { return iterator(verify_ok_); }
+        [[nodiscard]] auto end() const -> sentinel { return sentinel{}; }
+    };
+
+    /**
+     * Functor that, given a range, verifies it against an N-byte digest.
+     *
+     * The range is hashed straight into an N-byte buffer and compared in
+     * constant time over a compile-time length, without the padding and
+     * size checks a hash of unknown size needs.
+     * @tparam A The hash algorithm.
+     * @tparam N The digest size in bytes.
+     */
+    template <sph::hash_algorithm A, size_t N>
+    class fixed_hash_verify_fn : public std::ranges::range_adaptor_closure<fixed_hash_verify_fn<A, N>>
+    {
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+        sph::digest<A, N> hash_;
+        algorithm_parameters_t algorithm_parameters_{};
+    public:
+        explicit fixed_hash_verify_fn(sph::digest<A, N> const& hash) : hash_{ hash } {}
+
+        [[nodiscard]] auto with_blake2b_parameters(sph::blake2b_parameters parameters) const -> fixed_hash_verify_fn
+            requires (A == sph::hash_algorithm::blake2b || A == sph::hash_algorithm::blake2bp)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_blake2s_parameters(sph::blake2s_parameters parameters) const -> fixed_hash_verify_fn
+            requires (A == sph::hash_algorithm::blake2s || A == sph::hash_algorithm::blake2sp)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_siphash_parameters(sph::siphash_parameters parameters) const -> fixed_hash_verify_fn
+            requires (A == sph::hash_algorithm::siphash24 || A == sph::hash_algorithm::siphashx24)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_poly1305_parameters(sph::poly1305_parameters parameters) const -> fixed_hash_verify_fn
+            requires (A == sph::hash_algorithm::poly1305)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_k12_parameters(sph::k12_parameters parameters) const -> fixed_hash_verify_fn
+            requires (A == sph::hash_algorithm::k12)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_parallel_hash_parameters(sph::parallel_hash_parameters parameters) const -> fixed_hash_verify_fn
+            requires (A == sph::hash_algorithm::parallelhash128 || A == sph::hash_algorithm::parallelhash256)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_git_object_parameters(sph::git_object_parameters parameters) const -> fixed_hash_verify_fn
+            requires (A == sph::hash_algorithm::git_sha1 || A == sph::hash_algorithm::git_sha256)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        /**
+         * Gets a copy of this functor that verifies with the given
+         * algorithm-specific parameters (key, salt, etc.).
+         */
+        [[nodiscard]] auto with_algorithm_parameters(algorithm_parameters_t parameters) const -> fixed_hash_verify_fn
+            requires has_algorithm_parameters<A>
+        {
+            auto result{ *this };
+            result.algorithm_parameters_ = parameters;
+            return result;
+        }
+
+        template <hash_range R>
+        [[nodiscard]] auto operator()(R&& range) const -> hash_verify_result_view
+        {
+            std::array<uint8_t, N> computed{};
+            batch_hasher<A>{ N, algorithm_parameters_ }.hash(std::forward<R>(range), computed);
+            return hash_verify_result_view{ sodium_memcmp(computed.data(), hash_.data(), N) == 0 };
+        }
+    };
 }
 
 /**
@@ -532,10 +646,14 @@ namespace sph::ranges::views::detail
  * @tparam R The type of the range that holds a hashed stream.
  * @tparam T The type of the output range that holds a hashed stream.
  * @tparam A The type of the hash to do.
- * @tparam F The format of the hash (padded or raw).
+ * @tparam F The format of the hash (padded, raw, or text).
+ * @tparam S Where the hash is.
  */
-template <sph::ranges::views::detail::hash_range R, sph::ranges::views::detail::hashable_type T, sph::hash_algorithm A, sph::hash_format F>
-inline constexpr bool std::ranges::enable_borrowed_range<sph::ranges::views::detail::hash_verify_view<R, T, A, F>> = true;
+template <sph::ranges::views::detail::hash_range R, sph::ranges::views::detail::hashable_type T, sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
+inline constexpr bool std::ranges::enable_borrowed_range<sph::ranges::views::detail::hash_verify_view<R, T, A, F, S>> = true;
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<sph::ranges::views::detail::hash_verify_result_view> = true;
 
 namespace sph::views
 {
@@ -575,6 +693,38 @@ namespace sph::views
         return sph::ranges::views::detail::hash_verify_fn<sph::hash_algorithm::blake2b, std::nullopt_t, std::nullopt_t>{target_hash_size};
     }
 
+    /**
+     * A range adaptor that verifies a hash attached to the input where
+     * <code>sph::views::hash<A, T, F, S>()</code> writes it, e.g.
+     * <code>hash_verify<A, sph::hash_site::prepend>()</code> for a hash
+     * that comes before the payload. The payload is hashed as it is read;
+     * only the hash is kept.
+     *
+     * @tparam A The hash algorithm
+     * @tparam S Where the hash is: hash_site::append or hash_site::prepend.
+     * @param target_hash_size the size in bytes of the hash, before any
+     * padding or encoding.
+     * @return A functor that takes a range with an attached hash and returns a view of the verification status.
+     */
+    template<sph::hash_algorithm A, sph::hash_site S>
+        requires (S == sph::hash_site::append || S == sph::hash_site::prepend)
+    auto hash_verify(size_t target_hash_size = 0) -> sph::ranges::views::detail::hash_verify_fn<A, std::nullopt_t, std::nullopt_t, S>
+    {
+        return sph::ranges::views::detail::hash_verify_fn<A, std::nullopt_t, std::nullopt_t, S>{target_hash_size};
+    }
+    template<sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
+        requires (S == sph::hash_site::append || S == sph::hash_site::prepend)
+    auto hash_verify(size_t target_hash_size = 0) -> sph::ranges::views::detail::hash_verify_fn<A, ranges::views::detail::hash_verify_format_t<F>, std::nullopt_t, S>
+    {
+        return sph::ranges::views::detail::hash_verify_fn<A, ranges::views::detail::hash_verify_format_t<F>, std::nullopt_t, S>{target_hash_size};
+    }
+    template<sph::hash_algorithm A, sph::hash_site S, sph::hash_format F>
+        requires (S == sph::hash_site::append || S == sph::hash_site::prepend)
+    auto hash_verify(size_t target_hash_size = 0) -> sph::ranges::views::detail::hash_verify_fn<A, ranges::views::detail::hash_verify_format_t<F>, std::nullopt_t, S>
+    {
+        return sph::ranges::views::detail::hash_verify_fn<A, ranges::views::detail::hash_verify_format_t<F>, std::nullopt_t, S>{target_hash_size};
+    }
+
 
     /**
      * A range adaptor that represents view of an underlying single-element sequence of the hash verification.
@@ -613,4 +763,21 @@ namespace sph::views
         return sph::ranges::views::detail::hash_verify_fn<sph::hash_algorithm::blake2b, std::nullopt_t, H>{std::forward<H>(hash)};
     }
 
+    /**
+     * A range adaptor that verifies a range against a fixed-size digest, as
+     * <code>sph::views::hash<A, N>()</code> creates. The digest size is part
+     * of its type, so the comparison has a compile-time length.
+     *
+     * @tparam A The hash algorithm; the digest's algorithm.
+     * @param hash the <code>sph::digest<A, N></code> to compare against.
+     * @return A functor that takes a range and returns a view of the verification status.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::hash_range H>
+        requires sph::ranges::views::detail::is_digest<std::remove_cvref_t<H>>::value
+    auto hash_verify(H&& hash) -> sph::ranges::views::detail::fixed_hash_verify_fn<A, std::remove_cvref_t<H>::size()>
+    {
+        static_assert(std::remove_cvref_t<H>::algorithm == A, "The digest is from a different hash algorithm.");
+        return sph::ranges::views::detail::fixed_hash_verify_fn<A, std::remove_cvref_t<H>::size()>{ hash };
+    }
+
 }
@@ -0,0 +1,582 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sph/blake2b_parameters.h>
+#include <sph/blake2s_parameters.h>
+#include <sph/git_object_parameters.h>
+#include <sph/hash_algorithm.h>
+#include <sph/hash_format.h>
+#include <sph/hash_param.h>
+#include <sph/hash_site.h>
+#include <sph/hasher.h>
+#include <sph/interleave_parameters.h>
+#include <sph/k12_parameters.h>
+#include <sph/parallel_hash_parameters.h>
+#include <sph/poly1305_parameters.h>
+#include <sph/siphash_parameters.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/get_hash_size.h>
+#include <sph/ranges/views/detail/hash_interleave.h>
+#include <sph/ranges/views/detail/hash_util.h>
+#include <sph/ranges/views/detail/rolling_buffer.h>
+#include <sph/ranges/views/detail/text_encoding.h>
+#include <sph/ranges/views/detail/verify_util.h>
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * The iterator of a hash_verify_payload_view: hands out the payload
+     * elements of a range with a hash attached to it, hashing each one as it
+     * goes, and checks the hash when it reaches the end of the payload.
+     *
+     * A prepended hash is read first. For an appended hash, the last bytes
+     * read are held back in a rolling_buffer, since until the input ends
+     * there is no telling which of them are the hash. Either way, the hash
+     * is all that is kept of the input.
+     *
+     * Only one iterator can read the input, so it is move-only.
+     *
+     * @tparam R The view of the payload and its attached hash.
+     * @tparam A The hash algorithm.
+     * @tparam F The format of the attached hash (padded, raw, or text).
+     * @tparam S Where the hash is: hash_site::append or hash_site::prepend.
+     */
+    template<hash_range R, sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
+    class hash_verify_payload_iterator  // NOLINT(clang-diagnostic-padded)
+    {
+        static_assert(S != sph::hash_site::separate, "hash_verify_payload needs a hash appended or prepended to the payload.");
+        static_assert(S == sph::hash_site::prepend || !sph::hash_param<A>::git_object(), "A git object hash cannot verify a hash appended to its input.");
+        static_assert(S == sph::hash_site::append || std::forward_iterator<std::ranges::iterator_t<std::add_const_t<std::remove_reference_t<R>>>> || !sph::hash_param<A>::git_object(),
+            "A git object hash needs the payload size up front, so the input must be a forward range.");
+        static constexpr bool appended{ S == sph::hash_site::append };
+        using base_range_t = std::add_const_t<std::remove_reference_t<R>>;
+        using const_hashed_iterator_t = std::ranges::iterator_t<base_range_t>;
+        using const_hashed_sentinel_t = std::ranges::sentinel_t<base_range_t>;
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+    private:
+        using element_bytes_t = std::array<uint8_t, sizeof(value_type)>;
+        struct state
+        {
+            sph::hasher<A> hasher;
+            // the appended hash and the bytes that may yet turn out to be
+            // part of it, or the prepended hash
+            std::conditional_t<appended, rolling_buffer<value_type, A, F>, std::vector<uint8_t>> trailer{};
+        };
+        std::unique_ptr<state> state_;
+        const_hashed_iterator_t to_hash_current_;
+        const_hashed_sentinel_t to_hash_end_;
+        // the smallest the hash can be; a padded hash runs on to the next
+        // whole element
+        size_t trailer_size_;
+        bool* verified_;
+        element_bytes_t input_{};
+        size_t input_position_{ sizeof(value_type) };
+        value_type value_{};
+        bool complete_{ false };
+    public:
+        /**
+         * @param begin The start of the payload and its attached hash.
+         * @param end The end of the input.
+         * @param hash_size The size of the hash, before any padding or
+         * encoding.
+         * @param verified Where to write the verification result, if
+         * anywhere; false until the end of the input. If null, a hash that
+         * doesn't match throws std::runtime_error at the end instead.
+         * @param parameters The algorithm parameters (key, salt, etc.), if any.
+         */
+        template<typename... P>
+        hash_verify_payload_iterator(const_hashed_iterator_t begin, const_hashed_sentinel_t end, size_t hash_size, bool* verified, P const&... parameters)
+            : state_{ std::make_unique<state>(make_hasher(begin, end, hash_size, parameters...)) }
+            , to_hash_current_{ std::move(begin) }
+            , to_hash_end_{ std::move(end) }
+            , trailer_size_{ F == sph::hash_format::padded ? hash_size + 1 : encoded_size<F>(hash_size) }
+            , verified_{ verified }
+        {
+            if (verified_ != nullptr)
+            {
+                *verified_ = false;
+            }
+
+            if constexpr (!appended)
+            {
+                if (!read_prepended_hash())
+                {
+                    finish();
+                    return;
+                }
+            }
+
+            next_value();
+        }
+
+        hash_verify_payload_iterator(hash_verify_payload_iterator&&) noexcept = default;
+        hash_verify_payload_iterator(hash_verify_payload_iterator const&) = delete;
+        ~hash_verify_payload_iterator() = default;
+        auto operator=(hash_verify_payload_iterator&&) noexcept -> hash_verify_payload_iterator& = default;
+        auto operator=(hash_verify_payload_iterator const&) -> hash_verify_payload_iterator& = delete;
+
+        auto operator*() const -> value_type
+        {
+            assert(!complete_ && "Cannot dereference end of hash_verify_payload iterator.");
+            return value_;
+        }
+
+        auto operator++() -> hash_verify_payload_iterator&
+        {
+            if (complete_)
+            {
+                throw std::runtime_error("Attempt to increment past end of payload.");
+            }
+
+            next_value();
+            return *this;
+        }
+
+        auto operator++(int) -> void
+        {
+            ++*this;
+        }
+
+        auto operator==(std::default_sentinel_t) const noexcept -> bool
+        {
+            return complete_;
+        }
+
+    private:
+        /**
+         * Make the hasher. A git object hash of a prepended payload gets its
+         * size from the input, less the hash.
+         */
+        template<typename... P>
+        static auto make_hasher(const_hashed_iterator_t const& begin, const_hashed_sentinel_t const& end, size_t hash_size, P const&... parameters) -> sph::hasher<A>
+        {
+            if constexpr (sph::hash_param<A>::git_object())
+            {
+                auto const input_size{ static_cast<uint64_t>(std::ranges::distance(begin, end)) * sizeof(value_type) };
+                auto const leading_size{ leading_hash_size(hash_size) };
+                return sph::hasher<A>{ input_size > leading_size ? input_size - leading_size : 0, hash_size, parameters... };
+            }
+            else
+            {
+                return sph::hasher<A>{ hash_size, parameters... };
+            }
+        }
+
+        /**
+         * The size of a prepended hash: whole elements.
+         */
+        static auto leading_hash_size(size_t hash_size) -> size_t
+        {
+            auto const size{ F == sph::hash_format::padded ? hash_size + 1 : encoded_size<F>(hash_size) };
+            return (size + sizeof(value_type) - 1) / sizeof(value_type) * sizeof(value_type);
+        }
+
+        /**
+         * Read the prepended hash.
+         * @return false if the input is too short to hold it and a
+         * verification result is wanted; that throws std::runtime_error
+         * otherwise.
+         */
+        auto read_prepended_hash() -> bool
+            requires (!appended)
+        {
+            auto const size{ leading_hash_size(state_->hasher.digest_size()) };
+            auto& leading{ state_->trailer };
+            leading.reserve(size);
+            while (leading.size() < size)
+            {
+                if (to_hash_current_ == to_hash_end_)
+                {
+                    if (verified_ != nullptr)
+                    {
+                        return false;
+                    }
+
+                    throw std::runtime_error(std::format("Truncated data. Expected at least {} bytes, only {} bytes available.", size, leading.size()));
+                }
+
+                value_type const element{ *to_hash_current_ };
+                ++to_hash_current_;
+                element_bytes_t bytes{};
+                std::memcpy(bytes.data(), &element, sizeof(value_type));
+                leading.insert(leading.end(), bytes.begin(), bytes.end());
+            }
+
+            return true;
+        }
+
+        /**
+         * Read the next payload element and hash it, or, at the end of the
+         * payload, check the hash.
+         */
+        auto next_value() -> void
+        {
+            element_bytes_t bytes{};
+            for (auto& b : bytes)
+            {
+                auto const next{ next_payload_byte() };
+                if (!next)
+                {
+                    // the payload ends on a whole element, so only before
+                    // the first byte of one
+                    finish();
+                    return;
+                }
+
+                b = *next;
+            }
+
+            state_->hasher.update(bytes);
+            std::memcpy(&value_, bytes.data(), sizeof(value_type));
+        }
+
+        auto next_payload_byte() -> std::optional<uint8_t>
+            requires appended
+        {
+            auto& trailer{ state_->trailer };
+            while (!trailer.done())
+            {
+                if (input_position_ == sizeof(value_type))
+                {
+                    if (to_hash_current_ == to_hash_end_)
+                    {
+                        if (verified_ != nullptr && trailer.byte_count() < trailer_size_)
+                        {
+                            // too short to hold the hash; no payload to give
+                            return std::nullopt;
+                        }
+
+                        trailer.done(trailer_size_);
+                        break;
+                    }
+
+                    value_type const element{ *to_hash_current_ };
+                    ++to_hash_current_;
+                    std::memcpy(input_.data(), &element, sizeof(value_type));
+                    input_position_ = 0;
+                }
+
+                if (auto const b{ trailer.next(input_[input_position_++]) })
+                {
+                    return b;
+                }
+            }
+
+            if (auto const [valid, b] { trailer.next() }; valid)
+            {
+                return b;
+            }
+
+            return std::nullopt;
+        }
+
+        /**
+         * After a prepended hash, the rest of the input is all payload.
+         */
+        auto next_payload_byte() -> std::optional<uint8_t>
+            requires (!appended)
+        {
+            if (input_position_ == sizeof(value_type))
+            {
+                if (to_hash_current_ == to_hash_end_)
+                {
+                    return std::nullopt;
+                }
+
+                value_type const element{ *to_hash_current_ };
+                ++to_hash_current_;
+                std::memcpy(input_.data(), &element, sizeof(value_type));
+                input_position_ = 0;
+            }
+
+            return input_[input_position_++];
+        }
+
+        auto finish() -> void
+        {
+            complete_ = true;
+            auto const ok{ attached_hash_matches() };
+            if (verified_ != nullptr)
+            {
+                *verified_ = ok;
+            }
+            else if (!ok)
+            {
+                throw std::runtime_error(std::format("The {} hash {} to the input doesn't match the input.", sph::hash_param<A>::name(), appended ? "appended" : "prepended"));
+            }
+        }
+
+        auto attached_hash_matches() -> bool
+        {
+            auto& trailer{ state_->trailer };
+            auto const attached{ [&]() -> std::optional<hash_bytes>
+                {
+                    if constexpr (appended)
+                    {
+                        if (!trailer.done())
+                        {
+                            return std::nullopt;
+                        }
+
+                        auto const [data_end, end] { trailer.hash_positions() };
+                        return to_hash_bytes<F>(trailer.hash(end - data_end));
+                    }
+                    else
+                    {
+                        if (trailer.size() < leading_hash_size(state_->hasher.digest_size()))
+                        {
+                            return std::nullopt;
+                        }
+
+                        return to_hash_bytes<F>(trailer);
+                    }
+                }() };
+            if (!attached)
+            {
+                return false;
+            }
+
+            auto const digest{ state_->hasher.finalize() };
+            return attached->valid_padding
+                && attached->target_hash_size == digest.size()
+                && digests_equal(attached->bytes, digest, digest.size());
+        }
+    };
+
+    /**
+     * A view of the payload of a range that has a hash appended or
+     * prepended to it, with the hash checked at the end of the payload.
+     *
+     * The payload is hashed as it is read, so nothing more than the hash's
+     * length of input is ever held. The elements handed out before the end
+     * aren't verified yet.
+     *
+     * @tparam R The view of the payload and its attached hash.
+     * @tparam A The hash algorithm.
+     * @tparam F The format of the attached hash (padded, raw, or text).
+     * @tparam S Where the hash is: hash_site::append or hash_site::prepend.
+     */
+    template<hash_range R, sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
+        requires std::ranges::view<R>
+    class hash_verify_payload_view : public std::ranges::view_interface<hash_verify_payload_view<R, A, F, S>>
+    {
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+        R input_;
+        size_t target_hash_size_{};
+        algorithm_parameters_t algorithm_parameters_{};
+        bool* verified_{};
+    public:
+        using iterator = hash_verify_payload_iterator<R, A, F, S>;
+
+        hash_verify_payload_view() = default;
+
+        /**
+         * @param target_hash_size the size of the attached hash, before any
+         * padding or encoding; zero for the algorithm's default.
+         * @param input the payload and its attached hash.
+         * @param algorithm_parameters the algorithm parameters, if any.
+         * @param verified where to write the verification result; null to
+         * throw on a mismatch instead.
+         */
+        hash_verify_payload_view(size_t target_hash_size, R input, algorithm_parameters_t algorithm_parameters, bool* verified)
+            : input_{ std::move(input) }
+            , target_hash_size_{ get_hash_size<A, F, S>(target_hash_size) }
+            , algorithm_parameters_{ algorithm_parameters }
+            , verified_{ verified }
+        {
+        }
+
+        auto begin() const -> iterator
+        {
+            if constexpr (has_algorithm_parameters<A>)
+            {
+                return { std::ranges::begin(input_), std::ranges::end(input_), target_hash_size_, verified_, algorithm_parameters_ };
+            }
+            else
+            {
+                return { std::ranges::begin(input_), std::ranges::end(input_), target_hash_size_, verified_ };
+            }
+        }
+
+        // ReSharper disable once CppMemberFunctionMayBeStatic
+        auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+    };
+
+    /**
+     * Functor that, given a range with a hash attached to it, provides a
+     * view of its payload that checks the hash at the end, or, for an
+     * interleaved stream, checks each block before handing it out.
+     * @tparam A The hash algorithm.
+     * @tparam F The format of the attached hash.
+     * @tparam S Where the hash is: hash_site::append, hash_site::prepend,
+     * or hash_site::interleave.
+     */
+    template <sph::hash_algorithm A, sph::hash_format F, sph::hash_site S>
+    class hash_verify_payload_fn : public std::ranges::range_adaptor_closure<hash_verify_payload_fn<A, F, S>>
+    {
+        using algorithm_parameters_t = sph::ranges::views::detail::algorithm_parameters_t<A>;
+        size_t target_hash_size_;
+        algorithm_parameters_t algorithm_parameters_{};
+        bool* verified_{};
+        sph::interleave_parameters interleave_parameters_{};
+    public:
+        explicit hash_verify_payload_fn(size_t target_hash_size = 0) : target_hash_size_{ target_hash_size } {}
+
+        /**
+         * Gets a copy of this functor that reads an interleaved stream with
+         * the given block size and chaining; they must be what the stream
+         * was written with.
+         */
+        [[nodiscard]] auto with_interleave_parameters(sph::interleave_parameters parameters) const -> hash_verify_payload_fn
+            requires (S == sph::hash_site::interleave)
+        {
+            auto result{ *this };
+            result.interleave_parameters_ = parameters;
+            return result;
+        }
+
+        [[nodiscard]] auto with_blake2b_parameters(sph::blake2b_parameters parameters) const -> hash_verify_payload_fn
+            requires (A == sph::hash_algorithm::blake2b || A == sph::hash_algorithm::blake2bp)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_blake2s_parameters(sph::blake2s_parameters parameters) const -> hash_verify_payload_fn
+            requires (A == sph::hash_algorithm::blake2s || A == sph::hash_algorithm::blake2sp)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_siphash_parameters(sph::siphash_parameters parameters) const -> hash_verify_payload_fn
+            requires (A == sph::hash_algorithm::siphash24 || A == sph::hash_algorithm::siphashx24)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_poly1305_parameters(sph::poly1305_parameters parameters) const -> hash_verify_payload_fn
+            requires (A == sph::hash_algorithm::poly1305)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_k12_parameters(sph::k12_parameters parameters) const -> hash_verify_payload_fn
+            requires (A == sph::hash_algorithm::k12)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_parallel_hash_parameters(sph::parallel_hash_parameters parameters) const -> hash_verify_payload_fn
+            requires (A == sph::hash_algorithm::parallelhash128 || A == sph::hash_algorithm::parallelhash256)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        [[nodiscard]] auto with_git_object_parameters(sph::git_object_parameters parameters) const -> hash_verify_payload_fn
+            requires ((A == sph::hash_algorithm::git_sha1 || A == sph::hash_algorithm::git_sha256) && S == sph::hash_site::prepend)
+        {
+            return with_algorithm_parameters(parameters);
+        }
+
+        /**
+         * Gets a copy of this functor that verifies with the given
+         * algorithm-specific parameters (key, salt, etc.).
+         */
+        [[nodiscard]] auto with_algorithm_parameters(algorithm_parameters_t parameters) const -> hash_verify_payload_fn
+            requires has_algorithm_parameters<A>
+        {
+            auto result{ *this };
+            result.algorithm_parameters_ = parameters;
+            return result;
+        }
+
+        /**
+         * Gets a copy of this functor that writes the verification result to
+         * verified instead of throwing std::runtime_error on a mismatch.
+         * verified is false until the view's iterator reaches the end, so a
+         * payload that isn't read to the end is never verified. An
+         * interleaved stream ends at the first block that doesn't match.
+         * @param verified Where to write the result; it must outlive the
+         * iteration.
+         */
+        [[nodiscard]] auto with_verify_result(bool& verified) const -> hash_verify_payload_fn
+        {
+            auto result{ *this };
+            result.verified_ = &verified;
+            return result;
+        }
+
+        template <hash_range R>
+        [[nodiscard]] constexpr auto operator()(R&& range) const -> hash_verify_payload_view<std::views::all_t<R>, A, F, S>
+            requires (S != sph::hash_site::interleave)
+        {
+            return { target_hash_size_, std::views::all(std::forward<R>(range)), algorithm_parameters_, verified_ };
+        }
+
+        template <hash_range R>
+        [[nodiscard]] constexpr auto operator()(R&& range) const -> hash_verify_interleave_view<std::views::all_t<R>, A, F>
+            requires (S == sph::hash_site::interleave)
+        {
+            return { target_hash_size_, std::views::all(std::forward<R>(range)), interleave_parameters_, algorithm_parameters_, verified_ };
+        }
+    };
+}
+
+namespace sph::views
+{
+    /**
+     * A range adaptor that gives the payload of a range with a hash
+     * attached to it, as <code>sph::views::hash<A, T, F, S>()</code> writes
+     * it with <code>sph::hash_site::append</code> or
+     * <code>sph::hash_site::prepend</code>, and checks the hash once the
+     * payload has been read.
+     *
+     * The payload is hashed as it streams through, holding on to no more
+     * than the hash: a prepended hash is read first, and for an appended one
+     * only as many bytes as the hash can take up are held back. By default a
+     * hash that doesn't match throws std::runtime_error when the iterator
+     * reaches the end; <code>.with_verify_result(ok)</code> writes the result
+     * to a bool instead.
+     *
+     * An interleaved stream, from <code>sph::hash_site::interleave</code>,
+     * is read a block at a time and each block is checked before any of it
+     * is handed out, so corruption stops the payload at the first bad block.
+     * Its <code>.with_interleave_parameters()</code> must match the writer's.
+     *
+     * @tparam A The hash algorithm.
+     * @tparam F The format of the attached hash. Defaults to raw.
+     * @tparam S Where the hash is. Defaults to append.
+     * @param target_hash_size the size of the attached hash, before any
+     * padding or encoding; zero for the algorithm's default.
+     * @return A functor that takes a range with an attached hash and returns
+     * a view of its payload.
+     */
+    template<sph::hash_algorithm A, sph::hash_format F = sph::hash_format::raw, sph::hash_site S = sph::hash_site::append>
+        requires (S != sph::hash_site::separate)
+    auto hash_verify_payload(size_t target_hash_size = 0) -> sph::ranges::views::detail::hash_verify_payload_fn<A, F, S>
+    {
+        return sph::ranges::views::detail::hash_verify_payload_fn<A, F, S>{ target_hash_size };
+    }
+
+    template<sph::hash_algorithm A, sph::hash_site S, sph::hash_format F = sph::hash_format::raw>
+        requires (S != sph::hash_site::separate)
+    auto hash_verify_payload(size_t target_hash_size = 0) -> sph::ranges::views::detail::hash_verify_payload_fn<A, F, S>
+    {
+        return sph::ranges::views::detail::hash_verify_payload_fn<A, F, S>{ target_hash_size };
+    }
+}
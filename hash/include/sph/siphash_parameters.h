@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace sph
+{
+    /**
+     * @brief Parameters for hash_algorithm::siphash24 and hash_algorithm::siphashx24.
+     *
+     * SipHash is a keyed hash; the key must be exactly 16 bytes.
+     */
+    struct siphash_parameters
+    {
+        std::span<uint8_t const> key{};
+    };
+}
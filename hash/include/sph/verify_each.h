@@ -0,0 +1,182 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <sph/hash_algorithm.h>
+#include <sph/ranges/views/detail/algorithm_parameters.h>
+#include <sph/ranges/views/detail/batch_hasher.h>
+#include <sph/ranges/views/detail/hash_util.h>
+#include <sodium/utils.h>
+
+namespace sph
+{
+    /**
+     * Whether verify_each() checks every pair or stops at the first that
+     * fails.
+     */
+    enum class verify_each_mode
+    {
+        all,
+        stop_at_first_failure,
+    };
+
+    /**
+     * The outcome of verify_each().
+     */
+    struct verify_each_result
+    {
+        /**
+         * Bit i % 64 of word i / 64 is set when pair i verified.
+         */
+        std::vector<uint64_t> passed_bits;
+
+        /**
+         * The number of pairs checked; fewer than were given when stopped
+         * at the first failure.
+         */
+        size_t count{};
+
+        /**
+         * The index of the first pair that failed, if any.
+         */
+        std::optional<size_t> first_failure;
+
+        auto passed(size_t index) const -> bool
+        {
+            return index < count && ((passed_bits[index / 64] >> (index % 64)) & 1) != 0;
+        }
+
+        auto all_passed() const -> bool
+        {
+            return !first_failure.has_value();
+        }
+    };
+}
+
+namespace sph::ranges::views::detail
+{
+    /**
+     * A range of digests, each a range of bytes.
+     */
+    template <typename D>
+    concept digest_range = std::ranges::input_range<D>
+        && hash_range<std::ranges::range_reference_t<D>>
+        && (sizeof(std::remove_cvref_t<std::ranges::range_value_t<std::ranges::range_reference_t<D>>>) == 1);
+
+    /**
+     * Hash each message and compare it with its expected digest.
+     *
+     * The comparison is constant time, since a keyed algorithm's digest is
+     * an authentication tag. An expected digest of the wrong size fails.
+     */
+    template<sph::hash_algorithm A, message_range M, digest_range D>
+    auto verify_each_pair(M&& messages, D&& digests, batch_hasher<A> const& hasher, sph::verify_each_mode mode) -> sph::verify_each_result
+    {
+        if constexpr (std::ranges::sized_range<M> && std::ranges::sized_range<D>)
+        {
+            if (std::ranges::size(messages) != std::ranges::size(digests))
+            {
+                throw std::invalid_argument(std::format("Got {} messages but {} digests to verify them against.", std::ranges::size(messages), std::ranges::size(digests)));
+            }
+        }
+
+        sph::verify_each_result result{};
+        std::vector<uint8_t> computed(hasher.digest_size());
+        std::vector<uint8_t> expected;
+        expected.reserve(computed.size());
+        auto digest{ std::ranges::begin(digests) };
+        auto const digest_end{ std::ranges::end(digests) };
+        for (auto&& message : messages)
+        {
+            if (digest == digest_end)
+            {
+                throw std::invalid_argument(std::format("Ran out of digests after {} messages.", result.count));
+            }
+
+            hasher.hash(std::forward<decltype(message)>(message), computed);
+            expected.clear();
+            for (auto&& value : *digest)
+            {
+                expected.push_back(static_cast<uint8_t>(value));
+            }
+
+            auto const passed{ expected.size() == computed.size() && (computed.empty() || sodium_memcmp(expected.data(), computed.data(), computed.size()) == 0) };
+            if (result.count % 64 == 0)
+            {
+                result.passed_bits.push_back(0);
+            }
+
+            if (passed)
+            {
+                result.passed_bits.back() |= uint64_t{ 1 } << (result.count % 64);
+            }
+            else if (!result.first_failure.has_value())
+            {
+                result.first_failure = result.count;
+            }
+
+            ++result.count;
+            ++digest;
+            if (!passed && mode == sph::verify_each_mode::stop_at_first_failure)
+            {
+                return result;
+            }
+        }
+
+        if (digest != digest_end)
+        {
+            throw std::invalid_argument(std::format("Ran out of messages after {}, with digests left over.", result.count));
+        }
+
+        return result;
+    }
+}
+
+namespace sph
+{
+    /**
+     * Verify pairs of messages and expected digests: message i against
+     * digest i.
+     *
+     * Each message is hashed as <code>sph::hash_each()</code> hashes it,
+     * with the hash state set up once for the batch, and compared in
+     * constant time with its digest.
+     *
+     * Throws <code>std::invalid_argument</code> if there are not as many
+     * digests as messages.
+     *
+     * @tparam A The hash algorithm to use.
+     * @param messages The messages to verify.
+     * @param digests The expected raw digests, each a range of bytes. A
+     *      matrix like the one <code>sph::hash_each()</code> writes can be
+     *      passed as <code>digests | std::views::chunk(size)</code>.
+     * @param target_hash_size The size in bytes of each digest; zero for
+     *      <code>sph::hash_param<A>::hash_byte_count()</code>. Digests of any
+     *      other size fail.
+     * @param mode Whether to check every pair or stop at the first failure.
+     * @return which pairs verified, and the index of the first that didn't.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::message_range M, sph::ranges::views::detail::digest_range D>
+    auto verify_each(M&& messages, D&& digests, size_t target_hash_size = 0, verify_each_mode mode = verify_each_mode::all) -> verify_each_result
+    {
+        return sph::ranges::views::detail::verify_each_pair<A>(std::forward<M>(messages), std::forward<D>(digests), sph::ranges::views::detail::batch_hasher<A>{ target_hash_size }, mode);
+    }
+
+    /**
+     * Verify pairs of messages and expected digests with the given algorithm
+     * parameters (key, salt, etc.), which are validated once for the whole
+     * batch.
+     */
+    template<sph::hash_algorithm A, sph::ranges::views::detail::message_range M, sph::ranges::views::detail::digest_range D>
+        requires sph::ranges::views::detail::has_algorithm_parameters<A>
+    auto verify_each(M&& messages, D&& digests, size_t target_hash_size, sph::ranges::views::detail::algorithm_parameters_t<A> parameters, verify_each_mode mode = verify_each_mode::all) -> verify_each_result
+    {
+        return sph::ranges::views::detail::verify_each_pair<A>(std::forward<M>(messages), std::forward<D>(digests), sph::ranges::views::detail::batch_hasher<A>{ target_hash_size, parameters }, mode);
+    }
+}
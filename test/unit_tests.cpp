@@ -2,25 +2,47 @@
 #define _ENABLE_STL_INTERNAL_CHECK  // NOLINT(clang-diagnostic-reserved-macro-identifier)
 #include <array>
 #include <algorithm>
+#include <cctype>
 #include <chrono>
 #include <cstring>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 #include <magic_enum/magic_enum.hpp>
+#include <optional>
 #include <ranges>
 #include <span>
+#include <sph/copy_hash.h>
+#include <sph/digest.h>
+#include <sph/hash_each.h>
+#include <sph/hash_output_iterator.h>
+#include <sph/hasher.h>
+#include <sph/ranges/views/decode.h>
+#include <sph/ranges/views/detail/blake2_parallel.h>
 #include <sph/ranges/views/detail/blake2b.h>
+#include <sph/ranges/views/detail/blake2s.h>
 #include <sph/ranges/views/detail/blake3.h>
+#include <sph/ranges/views/detail/git_object.h>
+#include <sph/ranges/views/detail/kangaroo_twelve.h>
+#include <sph/ranges/views/detail/keccak_xof.h>
+#include <sph/ranges/views/detail/parallel_hash.h>
+#include <sph/ranges/views/detail/poly1305.h>
+#include <sph/ranges/views/detail/sha1.h>
 #include <sph/ranges/views/detail/sha3_256.h>
 #include <sph/ranges/views/detail/sha3_512.h>
 #include <sph/ranges/views/detail/sha256.h>
 #include <sph/ranges/views/detail/sha512.h>
+#include <sph/ranges/views/detail/siphash.h>
 #include <sph/ranges/views/hash.h>
 #include <sph/ranges/views/hash_verify.h>
+#include <sph/ranges/views/hash_verify_payload.h>
+#include <sph/verify_each.h>
 #include <sstream>
 #include <string_view>
+#include <type_traits>
+#include <unordered_set>
 #include <vector>
 #include <daw/json/daw_json_link.h>
 #ifdef __clang__
@@ -44,6 +66,7 @@ namespace
         std::vector<uint8_t> key;
         std::vector<uint8_t> salt;
         std::vector<uint8_t> personal;
+        size_t block_size;
     };
 
     struct test_vector_json
@@ -55,6 +78,7 @@ namespace
         std::string key;
         std::string salt;
         std::string personal;
+        std::optional<size_t> block_size;
         auto test_vector() const -> test_vector
         {
             auto hexstring_to_bytes = [](std::string const& value) -> std::vector<uint8_t>
@@ -74,7 +98,8 @@ namespace
                 .input = hexstring_to_bytes(input),
                 .key = hexstring_to_bytes(key),
                 .salt = hexstring_to_bytes(salt),
-                .personal = hexstring_to_bytes(personal)
+                .personal = hexstring_to_bytes(personal),
+                .block_size = block_size.value_or(0)
             };
         }
     };
@@ -92,6 +117,7 @@ namespace daw::json
         static constexpr char key[] = "key";
         static constexpr char salt[] = "salt";
         static constexpr char personal[] = "personal";
+        static constexpr char block_size[] = "block_size";
         using type = json_member_list<
             json_number<outlen, size_t>,
             json_number<input_repeat_count, size_t>,
@@ -99,7 +125,8 @@ namespace daw::json
             json_string<input, std::string>,
             json_string<key, std::string>,
             json_string<salt, std::string>,
-            json_string<personal, std::string>
+            json_string<personal, std::string>,
+            json_number_null<block_size, std::optional<size_t>>
         >;
     };
 
@@ -130,11 +157,29 @@ namespace
     }
 
     std::vector<test_vector> const blake2b_test_vectors {get_test_vector("blake2b.json")};
+    std::vector<test_vector> const blake2s_test_vectors {get_test_vector("blake2s.json")};
+    std::vector<test_vector> const blake2bp_test_vectors {get_test_vector("blake2bp.json")};
+    std::vector<test_vector> const blake2sp_test_vectors {get_test_vector("blake2sp.json")};
     std::vector<test_vector> const blake3_test_vectors {get_test_vector("blake3.json")};
+    std::vector<test_vector> const git_sha1_test_vectors {get_test_vector("git_sha1.json")};
+    std::vector<test_vector> const git_sha256_test_vectors {get_test_vector("git_sha256.json")};
+    std::vector<test_vector> const k12_test_vectors {get_test_vector("k12.json")};
+    std::vector<test_vector> const parallelhash128_test_vectors {get_test_vector("parallelhash128.json")};
+    std::vector<test_vector> const parallelhash256_test_vectors {get_test_vector("parallelhash256.json")};
+    std::vector<test_vector> const poly1305_test_vectors {get_test_vector("poly1305.json")};
+    std::vector<test_vector> const sha1_test_vectors {get_test_vector("sha1.json")};
     std::vector<test_vector> const sha256_test_vectors {get_test_vector("sha256.json")};
     std::vector<test_vector> const sha3_256_test_vectors {get_test_vector("sha3_256.json")};
     std::vector<test_vector> const sha3_512_test_vectors {get_test_vector("sha3_512.json")};
     std::vector<test_vector> const sha512_test_vectors {get_test_vector("sha512.json")};
+    std::vector<test_vector> const sha512_256_test_vectors {get_test_vector("sha512_256.json")};
+    std::vector<test_vector> const sha512_224_test_vectors {get_test_vector("sha512_224.json")};
+    std::vector<test_vector> const siphash24_test_vectors {get_test_vector("siphash24.json")};
+    std::vector<test_vector> const siphashx24_test_vectors {get_test_vector("siphashx24.json")};
+    std::vector<test_vector> const turboshake128_test_vectors {get_test_vector("turboshake128.json")};
+    std::vector<test_vector> const turboshake256_test_vectors {get_test_vector("turboshake256.json")};
+    std::vector<test_vector> const shake128_test_vectors {get_test_vector("shake128.json")};
+    std::vector<test_vector> const shake256_test_vectors {get_test_vector("shake256.json")};
 
     auto blake2b_parameters_from_test_vector(test_vector const& v) -> sph::blake2b_parameters
     {
@@ -145,6 +190,36 @@ namespace
         };
     }
 
+    auto blake2s_parameters_from_test_vector(test_vector const& v) -> sph::blake2s_parameters
+    {
+        return sph::blake2s_parameters{
+            .key = v.key,
+            .salt = v.salt,
+            .personal = v.personal
+        };
+    }
+
+    auto siphash_parameters_from_test_vector(test_vector const& v) -> sph::siphash_parameters
+    {
+        return sph::siphash_parameters{ .key = v.key };
+    }
+
+    auto poly1305_parameters_from_test_vector(test_vector const& v) -> sph::poly1305_parameters
+    {
+        return sph::poly1305_parameters{ .key = v.key };
+    }
+
+    // K12 vectors carry the customization string in the personal field
+    auto k12_parameters_from_test_vector(test_vector const& v) -> sph::k12_parameters
+    {
+        return sph::k12_parameters{ .customization = v.personal };
+    }
+
+    auto parallel_hash_parameters_from_test_vector(test_vector const& v) -> sph::parallel_hash_parameters
+    {
+        return sph::parallel_hash_parameters{ .block_size = v.block_size, .customization = v.personal };
+    }
+
     template<typename H>
     constexpr auto hash_to_byte_vector(H&& hash) -> std::vector<uint8_t>
     {
@@ -182,9 +257,33 @@ namespace
     template <>
     struct detail_hash_type<sph::hash_algorithm::blake2b> { using type = sph::ranges::views::detail::blake2b; };
 
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::blake2s> { using type = sph::ranges::views::detail::blake2s; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::blake2bp> { using type = sph::ranges::views::detail::blake2bp; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::blake2sp> { using type = sph::ranges::views::detail::blake2sp; };
+
     template <>
     struct detail_hash_type<sph::hash_algorithm::blake3> { using type = sph::ranges::views::detail::blake3; };
 
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::git_sha1> { using type = sph::ranges::views::detail::git_sha1; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::git_sha256> { using type = sph::ranges::views::detail::git_sha256; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::k12> { using type = sph::ranges::views::detail::k12; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::poly1305> { using type = sph::ranges::views::detail::poly1305; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::sha1> { using type = sph::ranges::views::detail::sha1; };
+
     template <>
     struct detail_hash_type<sph::hash_algorithm::sha256> { using type = sph::ranges::views::detail::sha256; };
 
@@ -197,6 +296,38 @@ namespace
     template <>
     struct detail_hash_type<sph::hash_algorithm::sha512> { using type = sph::ranges::views::detail::sha512; };
 
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::sha512_256> { using type = sph::ranges::views::detail::sha512_256; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::sha512_224> { using type = sph::ranges::views::detail::sha512_224; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::siphash24> { using type = sph::ranges::views::detail::siphash24; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::siphashx24> { using type = sph::ranges::views::detail::siphashx24; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::turboshake128> { using type = sph::ranges::views::detail::turboshake128; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::turboshake256> { using type = sph::ranges::views::detail::turboshake256; };
+
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::shake128> { using type = sph::ranges::views::detail::shake128; };
+
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::shake256> { using type = sph::ranges::views::detail::shake256; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::parallelhash128> { using type = sph::ranges::views::detail::parallelhash128; };
+
+    template <>
+    struct detail_hash_type<sph::hash_algorithm::parallelhash256> { using type = sph::ranges::views::detail::parallelhash256; };
+
     template <sph::hash_algorithm A>
     using detail_hash_t = typename detail_hash_type<A>::type;
 
@@ -231,23 +362,85 @@ namespace
         hasher.final(std::span<uint8_t const>{ chunk.data(), filled });
     }
 
+    /**
+     * All of the hash; extendable output is read one block at a time.
+     */
+    template <typename H>
+    auto read_hash(H& hasher) -> std::vector<uint8_t>
+    {
+        auto hash{ hasher.hash() };
+        std::vector<uint8_t> ret{ hash.begin(), hash.end() };
+        if constexpr (sph::ranges::views::detail::extendable_hash<H>)
+        {
+            while (ret.size() < hasher.target_hash_size())
+            {
+                hasher.next_block();
+                auto block{ hasher.hash() };
+                ret.insert(ret.end(), block.begin(), block.end());
+            }
+        }
+
+        return ret;
+    }
+
     template <sph::hash_algorithm A>
     auto hash_test_vector(test_vector const& test_vector) -> std::vector<uint8_t>
     {
-        if constexpr (A == sph::hash_algorithm::blake2b)
+        if constexpr (A == sph::hash_algorithm::blake2b || A == sph::hash_algorithm::blake2bp)
         {
             auto hasher{ detail_hash_t<A>{ test_vector.outlen, blake2b_parameters_from_test_vector(test_vector) } };
             feed_test_vector(hasher, test_vector);
             auto hash{ hasher.hash() };
             return { hash.begin(), hash.end() };
         }
-        else
+        else if constexpr (A == sph::hash_algorithm::blake2s || A == sph::hash_algorithm::blake2sp)
         {
-            auto hasher{ detail_hash_t<A>{ test_vector.outlen } };
+            auto hasher{ detail_hash_t<A>{ test_vector.outlen, blake2s_parameters_from_test_vector(test_vector) } };
+            feed_test_vector(hasher, test_vector);
+            auto hash{ hasher.hash() };
+            return { hash.begin(), hash.end() };
+        }
+        else if constexpr (A == sph::hash_algorithm::siphash24 || A == sph::hash_algorithm::siphashx24)
+        {
+            auto hasher{ detail_hash_t<A>{ test_vector.outlen, siphash_parameters_from_test_vector(test_vector) } };
+            feed_test_vector(hasher, test_vector);
+            auto hash{ hasher.hash() };
+            return { hash.begin(), hash.end() };
+        }
+        else if constexpr (A == sph::hash_algorithm::poly1305)
+        {
+            auto hasher{ detail_hash_t<A>{ test_vector.outlen, poly1305_parameters_from_test_vector(test_vector) } };
+            feed_test_vector(hasher, test_vector);
+            auto hash{ hasher.hash() };
+            return { hash.begin(), hash.end() };
+        }
+        else if constexpr (A == sph::hash_algorithm::k12)
+        {
+            auto hasher{ detail_hash_t<A>{ test_vector.outlen, k12_parameters_from_test_vector(test_vector) } };
+            feed_test_vector(hasher, test_vector);
+            return read_hash(hasher);
+        }
+        else if constexpr (A == sph::hash_algorithm::parallelhash128 || A == sph::hash_algorithm::parallelhash256)
+        {
+            auto hasher{ detail_hash_t<A>{ test_vector.outlen, parallel_hash_parameters_from_test_vector(test_vector) } };
+            feed_test_vector(hasher, test_vector);
+            auto hash{ hasher.hash() };
+            return { hash.begin(), hash.end() };
+        }
+        else if constexpr (sph::hash_param<A>::git_object())
+        {
+            // git object vectors are all blobs
+            auto hasher{ detail_hash_t<A>{ test_vector.outlen, sph::git_object_parameters{}, test_vector.input.size() * test_vector.input_repeat_count } };
             feed_test_vector(hasher, test_vector);
             auto hash{ hasher.hash() };
             return { hash.begin(), hash.end() };
         }
+        else
+        {
+            auto hasher{ detail_hash_t<A>{ test_vector.outlen } };
+            feed_test_vector(hasher, test_vector);
+            return read_hash(hasher);
+        }
     }
 
     template <sph::hash_algorithm A>
@@ -995,12 +1188,78 @@ TEST_CASE("hash.vectors")
         CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed blake on test vector {}", test_name, index));
     }
 
+    for (auto const [index, test_vector] : std::views::enumerate(blake2s_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::blake2s>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed blake2s on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(blake2bp_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::blake2bp>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed blake2bp on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(blake2sp_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::blake2sp>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed blake2sp on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(k12_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::k12>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed k12 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(turboshake128_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::turboshake128>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed turboshake128 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(turboshake256_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::turboshake256>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed turboshake256 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(shake128_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::shake128>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed shake128 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(shake256_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::shake256>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed shake256 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(parallelhash128_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::parallelhash128>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed parallelhash128 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(parallelhash256_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::parallelhash256>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed parallelhash256 on test vector {}", test_name, index));
+    }
+
     for (auto const [index, test_vector] : std::views::enumerate(blake3_test_vectors))
     {
         auto hash = hash_test_vector<sph::hash_algorithm::blake3>(test_vector);
         CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed blake3 on test vector {}", test_name, index));
     }
 
+    for (auto const [index, test_vector] : std::views::enumerate(poly1305_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::poly1305>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed poly1305 on test vector {}", test_name, index));
+    }
+
     for (auto const [index, test_vector] : std::views::enumerate(sha256_test_vectors))
     {
         auto hash = hash_test_vector<sph::hash_algorithm::sha256>(test_vector);
@@ -1024,6 +1283,48 @@ TEST_CASE("hash.vectors")
         auto hash = hash_test_vector<sph::hash_algorithm::sha512>(test_vector);
         CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed sha512 on test vector {}", test_name, index));
     }
+
+    for (auto const [index, test_vector] : std::views::enumerate(sha512_256_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::sha512_256>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed sha512_256 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(sha512_224_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::sha512_224>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed sha512_224 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(sha1_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::sha1>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed sha1 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(git_sha1_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::git_sha1>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed git_sha1 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(git_sha256_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::git_sha256>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed git_sha256 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(siphash24_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::siphash24>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed siphash24 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(siphashx24_test_vectors))
+    {
+        auto hash = hash_test_vector<sph::hash_algorithm::siphashx24>(test_vector);
+        CHECK_MESSAGE(hash == test_vector.out, fmt::format("{}: failed siphashx24 on test vector {}", test_name, index));
+    }
 }
 
 TEST_CASE("hash.hash_overloads")
@@ -1032,6 +1333,46 @@ TEST_CASE("hash.hash_overloads")
     {
         hash_overloads<sph::hash_algorithm::blake2b>();
     }
+    SUBCASE("blake2s")
+    {
+        hash_overloads<sph::hash_algorithm::blake2s>();
+    }
+    SUBCASE("blake2bp")
+    {
+        hash_overloads<sph::hash_algorithm::blake2bp>();
+    }
+    SUBCASE("blake2sp")
+    {
+        hash_overloads<sph::hash_algorithm::blake2sp>();
+    }
+    SUBCASE("k12")
+    {
+        hash_overloads<sph::hash_algorithm::k12>();
+    }
+    SUBCASE("turboshake128")
+    {
+        hash_overloads<sph::hash_algorithm::turboshake128>();
+    }
+    SUBCASE("turboshake256")
+    {
+        hash_overloads<sph::hash_algorithm::turboshake256>();
+    }
+    SUBCASE("shake128")
+    {
+        hash_overloads<sph::hash_algorithm::shake128>();
+    }
+    SUBCASE("shake256")
+    {
+        hash_overloads<sph::hash_algorithm::shake256>();
+    }
+    SUBCASE("parallelhash128")
+    {
+        hash_overloads<sph::hash_algorithm::parallelhash128>();
+    }
+    SUBCASE("parallelhash256")
+    {
+        hash_overloads<sph::hash_algorithm::parallelhash256>();
+    }
     SUBCASE("blake3")
     {
         hash_overloads<sph::hash_algorithm::blake3>();
@@ -1052,6 +1393,18 @@ TEST_CASE("hash.hash_overloads")
     {
         hash_overloads<sph::hash_algorithm::sha512>();
     }
+    SUBCASE("sha512_256")
+    {
+        hash_overloads<sph::hash_algorithm::sha512_256>();
+    }
+    SUBCASE("sha512_224")
+    {
+        hash_overloads<sph::hash_algorithm::sha512_224>();
+    }
+    SUBCASE("git_sha256")
+    {
+        hash_overloads<sph::hash_algorithm::git_sha256>();
+    }
 }
 
 TEST_CASE("hash.hash_to_size_t")
@@ -1060,6 +1413,46 @@ TEST_CASE("hash.hash_to_size_t")
     {
         hash_to_size_t<sph::hash_algorithm::blake2b>();
     }
+    SUBCASE("blake2s")
+    {
+        hash_to_size_t<sph::hash_algorithm::blake2s>();
+    }
+    SUBCASE("blake2bp")
+    {
+        hash_to_size_t<sph::hash_algorithm::blake2bp>();
+    }
+    SUBCASE("blake2sp")
+    {
+        hash_to_size_t<sph::hash_algorithm::blake2sp>();
+    }
+    SUBCASE("k12")
+    {
+        hash_to_size_t<sph::hash_algorithm::k12>();
+    }
+    SUBCASE("turboshake128")
+    {
+        hash_to_size_t<sph::hash_algorithm::turboshake128>();
+    }
+    SUBCASE("turboshake256")
+    {
+        hash_to_size_t<sph::hash_algorithm::turboshake256>();
+    }
+    SUBCASE("shake128")
+    {
+        hash_to_size_t<sph::hash_algorithm::shake128>();
+    }
+    SUBCASE("shake256")
+    {
+        hash_to_size_t<sph::hash_algorithm::shake256>();
+    }
+    SUBCASE("parallelhash128")
+    {
+        hash_to_size_t<sph::hash_algorithm::parallelhash128>();
+    }
+    SUBCASE("parallelhash256")
+    {
+        hash_to_size_t<sph::hash_algorithm::parallelhash256>();
+    }
     SUBCASE("blake3")
     {
         hash_to_size_t<sph::hash_algorithm::blake3>();
@@ -1080,6 +1473,18 @@ TEST_CASE("hash.hash_to_size_t")
     {
         hash_to_size_t<sph::hash_algorithm::sha512>();
     }
+    SUBCASE("sha512_256")
+    {
+        hash_to_size_t<sph::hash_algorithm::sha512_256>();
+    }
+    SUBCASE("sha512_224")
+    {
+        hash_to_size_t<sph::hash_algorithm::sha512_224>();
+    }
+    SUBCASE("git_sha256")
+    {
+        hash_to_size_t<sph::hash_algorithm::git_sha256>();
+    }
 }
 
 TEST_CASE("hash_verify.vectors")
@@ -1092,6 +1497,76 @@ TEST_CASE("hash_verify.vectors")
         CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake on test vector {}", test_name, index));
     }
 
+    for (auto const [index, test_vector] : std::views::enumerate(blake2s_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::blake2s>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed blake2s on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake2s on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(blake2bp_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::blake2bp>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed blake2bp on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake2bp on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(blake2sp_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::blake2sp>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed blake2sp on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake2sp on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(k12_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::k12>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed k12 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed k12 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(turboshake128_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::turboshake128>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed turboshake128 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed turboshake128 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(turboshake256_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::turboshake256>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed turboshake256 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed turboshake256 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(shake128_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::shake128>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed shake128 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed shake128 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(shake256_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::shake256>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed shake256 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed shake256 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(parallelhash128_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::parallelhash128>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed parallelhash128 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed parallelhash128 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(parallelhash256_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::parallelhash256>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed parallelhash256 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed parallelhash256 on test vector {}", test_name, index));
+    }
+
     for (auto const [index, test_vector] : std::views::enumerate(blake3_test_vectors))
     {
         auto verify { verify_test_vector<sph::hash_algorithm::blake3>(test_vector) };
@@ -1099,6 +1574,13 @@ TEST_CASE("hash_verify.vectors")
         CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake3 on test vector {}", test_name, index));
     }
 
+    for (auto const [index, test_vector] : std::views::enumerate(poly1305_test_vectors))
+    {
+        auto verify { verify_test_vector<sph::hash_algorithm::poly1305>(test_vector) };
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed poly1305 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed poly1305 on test vector {}", test_name, index));
+    }
+
     for (auto const [index, test_vector] : std::views::enumerate(sha256_test_vectors))
     {
         auto verify = verify_test_vector<sph::hash_algorithm::sha256>(test_vector);
@@ -1127,23 +1609,112 @@ TEST_CASE("hash_verify.vectors")
         CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake on test vector {}", test_name, index));
     }
 
-}
-
-TEST_CASE("hash_verify.overloads.separate")
-{
-    SUBCASE("blake2b.uint8_t")
+    for (auto const [index, test_vector] : std::views::enumerate(sha512_256_test_vectors))
     {
-        hash_verify_overloads_separate<sph::hash_algorithm::blake2b, uint8_t>();
+        auto verify = verify_test_vector<sph::hash_algorithm::sha512_256>(test_vector);
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed blake on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake on test vector {}", test_name, index));
     }
-    SUBCASE("blake3.uint8_t")
+
+    for (auto const [index, test_vector] : std::views::enumerate(sha512_224_test_vectors))
     {
-        hash_verify_overloads_separate<sph::hash_algorithm::blake3, uint8_t>();
+        auto verify = verify_test_vector<sph::hash_algorithm::sha512_224>(test_vector);
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed blake on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake on test vector {}", test_name, index));
     }
-    SUBCASE("sha256.uint8_t")
+
+    for (auto const [index, test_vector] : std::views::enumerate(sha1_test_vectors))
     {
-        hash_verify_overloads_separate<sph::hash_algorithm::sha256, uint8_t>();
+        auto verify = verify_test_vector<sph::hash_algorithm::sha1>(test_vector);
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed blake on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake on test vector {}", test_name, index));
     }
-    SUBCASE("sha3_256.uint8_t")
+
+    for (auto const [index, test_vector] : std::views::enumerate(git_sha1_test_vectors))
+    {
+        auto verify = verify_test_vector<sph::hash_algorithm::git_sha1>(test_vector);
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed blake on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(git_sha256_test_vectors))
+    {
+        auto verify = verify_test_vector<sph::hash_algorithm::git_sha256>(test_vector);
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed blake on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed blake on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(siphash24_test_vectors))
+    {
+        auto verify = verify_test_vector<sph::hash_algorithm::siphash24>(test_vector);
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed siphash24 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed siphash24 on test vector {}", test_name, index));
+    }
+
+    for (auto const [index, test_vector] : std::views::enumerate(siphashx24_test_vectors))
+    {
+        auto verify = verify_test_vector<sph::hash_algorithm::siphashx24>(test_vector);
+        CHECK_MESSAGE(verify.size() == 1, fmt::format("{}: failed siphashx24 on test vector {}", test_name, index));
+        CHECK_MESSAGE(verify.front() == true, fmt::format("{}: failed siphashx24 on test vector {}", test_name, index));
+    }
+
+}
+
+TEST_CASE("hash_verify.overloads.separate")
+{
+    SUBCASE("blake2b.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::blake2b, uint8_t>();
+    }
+    SUBCASE("blake2s.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::blake2s, uint8_t>();
+    }
+    SUBCASE("blake2bp.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::blake2bp, uint8_t>();
+    }
+    SUBCASE("blake2sp.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::blake2sp, uint8_t>();
+    }
+    SUBCASE("k12.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::k12, uint8_t>();
+    }
+    SUBCASE("turboshake128.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::turboshake128, uint8_t>();
+    }
+    SUBCASE("turboshake256.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::turboshake256, uint8_t>();
+    }
+    SUBCASE("shake128.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::shake128, uint8_t>();
+    }
+    SUBCASE("shake256.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::shake256, uint8_t>();
+    }
+    SUBCASE("parallelhash128.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::parallelhash128, uint8_t>();
+    }
+    SUBCASE("parallelhash256.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::parallelhash256, uint8_t>();
+    }
+    SUBCASE("blake3.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::blake3, uint8_t>();
+    }
+    SUBCASE("sha256.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::sha256, uint8_t>();
+    }
+    SUBCASE("sha3_256.uint8_t")
     {
         hash_verify_overloads_separate<sph::hash_algorithm::sha3_256, uint8_t>();
     }
@@ -1155,10 +1726,62 @@ TEST_CASE("hash_verify.overloads.separate")
     {
         hash_verify_overloads_separate<sph::hash_algorithm::sha512, uint8_t>();
     }
+    SUBCASE("sha512_256.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::sha512_256, uint8_t>();
+    }
+    SUBCASE("sha512_224.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::sha512_224, uint8_t>();
+    }
+    SUBCASE("git_sha256.uint8_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::git_sha256, uint8_t>();
+    }
     SUBCASE("blake2b.size_t")
     {
         hash_verify_overloads_separate<sph::hash_algorithm::blake2b, size_t>();
     }
+    SUBCASE("blake2s.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::blake2s, size_t>();
+    }
+    SUBCASE("blake2bp.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::blake2bp, size_t>();
+    }
+    SUBCASE("blake2sp.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::blake2sp, size_t>();
+    }
+    SUBCASE("k12.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::k12, size_t>();
+    }
+    SUBCASE("turboshake128.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::turboshake128, size_t>();
+    }
+    SUBCASE("turboshake256.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::turboshake256, size_t>();
+    }
+    SUBCASE("shake128.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::shake128, size_t>();
+    }
+    SUBCASE("shake256.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::shake256, size_t>();
+    }
+    SUBCASE("parallelhash128.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::parallelhash128, size_t>();
+    }
+    SUBCASE("parallelhash256.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::parallelhash256, size_t>();
+    }
     SUBCASE("blake3.size_t")
     {
         hash_verify_overloads_separate<sph::hash_algorithm::blake3, size_t>();
@@ -1179,6 +1802,18 @@ TEST_CASE("hash_verify.overloads.separate")
     {
         hash_verify_overloads_separate<sph::hash_algorithm::sha512, size_t>();
     }
+    SUBCASE("sha512_256.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::sha512_256, size_t>();
+    }
+    SUBCASE("sha512_224.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::sha512_224, size_t>();
+    }
+    SUBCASE("git_sha256.size_t")
+    {
+        hash_verify_overloads_separate<sph::hash_algorithm::git_sha256, size_t>();
+    }
 }
 TEST_CASE("roundtrip")
 {
@@ -1186,6 +1821,46 @@ TEST_CASE("roundtrip")
     {
         hash_roundtrip_separate_types_format<sph::hash_algorithm::blake2b>();
     }
+    SUBCASE("blake2s.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::blake2s>();
+    }
+    SUBCASE("blake2bp.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::blake2bp>();
+    }
+    SUBCASE("blake2sp.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::blake2sp>();
+    }
+    SUBCASE("k12.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::k12>();
+    }
+    SUBCASE("turboshake128.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::turboshake128>();
+    }
+    SUBCASE("turboshake256.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::turboshake256>();
+    }
+    SUBCASE("shake128.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::shake128>();
+    }
+    SUBCASE("shake256.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::shake256>();
+    }
+    SUBCASE("parallelhash128.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::parallelhash128>();
+    }
+    SUBCASE("parallelhash256.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::parallelhash256>();
+    }
     SUBCASE("blake3.separate")
     {
         hash_roundtrip_separate_types_format<sph::hash_algorithm::blake3>();
@@ -1206,10 +1881,62 @@ TEST_CASE("roundtrip")
     {
         hash_roundtrip_separate_types_format<sph::hash_algorithm::sha512>();
     }
+    SUBCASE("sha512_256.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::sha512_256>();
+    }
+    SUBCASE("sha512_224.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::sha512_224>();
+    }
+    SUBCASE("git_sha256.separate")
+    {
+        hash_roundtrip_separate_types_format<sph::hash_algorithm::git_sha256>();
+    }
     SUBCASE("blake2b.append")
     {
         hash_roundtrip_append_types_format<sph::hash_algorithm::blake2b>();
     }
+    SUBCASE("blake2s.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::blake2s>();
+    }
+    SUBCASE("blake2bp.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::blake2bp>();
+    }
+    SUBCASE("blake2sp.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::blake2sp>();
+    }
+    SUBCASE("k12.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::k12>();
+    }
+    SUBCASE("turboshake128.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::turboshake128>();
+    }
+    SUBCASE("turboshake256.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::turboshake256>();
+    }
+    SUBCASE("shake128.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::shake128>();
+    }
+    SUBCASE("shake256.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::shake256>();
+    }
+    SUBCASE("parallelhash128.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::parallelhash128>();
+    }
+    SUBCASE("parallelhash256.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::parallelhash256>();
+    }
     SUBCASE("blake3.append")
     {
         hash_roundtrip_append_types_format<sph::hash_algorithm::blake3>();
@@ -1230,6 +1957,14 @@ TEST_CASE("roundtrip")
     {
         hash_roundtrip_append_types_format<sph::hash_algorithm::sha512>();
     }
+    SUBCASE("sha512_256.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::sha512_256>();
+    }
+    SUBCASE("sha512_224.append")
+    {
+        hash_roundtrip_append_types_format<sph::hash_algorithm::sha512_224>();
+    }
 }
 
 TEST_CASE("hash_verify.negative")
@@ -1475,6 +2210,1690 @@ TEST_CASE("hash.blake2b.parameter_validation")
     }
 }
 
+TEST_CASE("hash.siphash")
+{
+    std::array<uint8_t, 16> key{};
+    std::ranges::copy(std::views::iota(0, 16) | std::views::transform([](int i) -> uint8_t { return static_cast<uint8_t>(i); }), key.begin());
+    std::vector<uint8_t> const input{ 'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd' };
+
+    SUBCASE("short.key.rejected")
+    {
+        std::array<uint8_t, 15> short_key{};
+        auto hasher = sph::views::hash<sph::hash_algorithm::siphash24>()
+            .with_siphash_parameters(sph::siphash_parameters{ .key = short_key });
+        bool threw{ false };
+        try
+        {
+            auto unused = input | hasher | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    SUBCASE("contiguous.matches.streamed")
+    {
+        // A vector hashes in one shot; a transformed view goes through update().
+        std::vector<uint8_t> long_input(300);
+        std::ranges::copy(std::views::iota(0, 300) | std::views::transform([](int i) -> uint8_t { return static_cast<uint8_t>(i); }), long_input.begin());
+        auto const parameters{ sph::siphash_parameters{ .key = key } };
+        auto const contiguous = long_input
+            | sph::views::hash<sph::hash_algorithm::siphashx24>().with_siphash_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        auto const streamed = long_input
+            | std::views::transform([](uint8_t v) -> uint8_t { return v; })
+            | sph::views::hash<sph::hash_algorithm::siphashx24>().with_siphash_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(contiguous.size() == 16);
+        CHECK(contiguous == streamed);
+    }
+
+    SUBCASE("keyed.verify")
+    {
+        auto const parameters{ sph::siphash_parameters{ .key = key } };
+        auto const hash = input
+            | sph::views::hash<sph::hash_algorithm::siphash24>().with_siphash_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        auto const verify = input
+            | sph::views::hash_verify<sph::hash_algorithm::siphash24>(hash).with_siphash_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+
+        std::array<uint8_t, 16> other_key{ key };
+        other_key.back() ^= 0x01;
+        auto const verify_other = input
+            | sph::views::hash_verify<sph::hash_algorithm::siphash24>(hash).with_siphash_parameters(sph::siphash_parameters{ .key = other_key })
+            | std::ranges::to<std::vector>();
+        CHECK_FALSE(verify_other.front());
+    }
+
+    SUBCASE("keyed.append.roundtrip")
+    {
+        auto const parameters{ sph::siphash_parameters{ .key = key } };
+        auto const appended = input
+            | sph::views::hash<sph::hash_algorithm::siphash24, uint8_t, sph::hash_format::raw, sph::hash_site::append>().with_siphash_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(appended.size() == input.size() + 8);
+        auto const verify = appended
+            | sph::views::hash_verify<sph::hash_algorithm::siphash24>().with_siphash_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+    }
+}
+
+TEST_CASE("hash.poly1305")
+{
+    std::array<uint8_t, 32> key{};
+    std::ranges::copy(std::views::iota(0, 32) | std::views::transform([](int i) -> uint8_t { return static_cast<uint8_t>(i * 7 + 3); }), key.begin());
+    auto const parameters{ sph::poly1305_parameters{ .key = key } };
+    std::vector<uint8_t> const packet{ 'p', 'a', 'c', 'k', 'e', 't', ' ', 'p', 'a', 'y', 'l', 'o', 'a', 'd' };
+
+    SUBCASE("short.key.rejected")
+    {
+        std::array<uint8_t, 16> short_key{};
+        auto hasher = sph::views::hash<sph::hash_algorithm::poly1305>()
+            .with_poly1305_parameters(sph::poly1305_parameters{ .key = short_key });
+        bool threw{ false };
+        try
+        {
+            auto unused = packet | hasher | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    SUBCASE("separate.verify")
+    {
+        auto const tag = packet
+            | sph::views::hash<sph::hash_algorithm::poly1305>().with_poly1305_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(tag.size() == 16);
+        auto const verify = packet
+            | sph::views::hash_verify<sph::hash_algorithm::poly1305>(tag).with_poly1305_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+
+        auto forged{ tag };
+        forged.back() ^= 0x01;
+        auto const verify_forged = packet
+            | sph::views::hash_verify<sph::hash_algorithm::poly1305>(forged).with_poly1305_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK_FALSE(verify_forged.front());
+    }
+
+    SUBCASE("append.roundtrip")
+    {
+        auto framed = packet
+            | sph::views::hash<sph::hash_algorithm::poly1305, uint8_t, sph::hash_format::raw, sph::hash_site::append>().with_poly1305_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(framed.size() == packet.size() + 16);
+        auto const verify = framed
+            | sph::views::hash_verify<sph::hash_algorithm::poly1305>().with_poly1305_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+
+        framed.front() ^= 0x01;
+        auto const verify_tampered = framed
+            | sph::views::hash_verify<sph::hash_algorithm::poly1305>().with_poly1305_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK_FALSE(verify_tampered.front());
+    }
+}
+
+TEST_CASE("hash.blake2s.parameter_validation")
+{
+    std::vector<uint8_t> const input{ 0x01, 0x02, 0x03 };
+
+    SUBCASE("oversized.key.rejected")
+    {
+        std::vector<uint8_t> key(33, 0x01);
+        auto hasher = sph::views::hash<sph::hash_algorithm::blake2s>(24)
+            .with_blake2s_parameters(sph::blake2s_parameters{ .key = key });
+        bool threw{ false };
+        try
+        {
+            auto unused = input | hasher | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    SUBCASE("bad.salt.size.rejected")
+    {
+        std::array<uint8_t, 16> salt{};
+        auto hasher = sph::views::hash<sph::hash_algorithm::blake2s>(24)
+            .with_blake2s_parameters(sph::blake2s_parameters{ .salt = salt });
+        bool threw{ false };
+        try
+        {
+            auto unused = input | hasher | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    SUBCASE("bad.personal.size.rejected")
+    {
+        std::array<uint8_t, 16> personal{};
+        auto hasher = sph::views::hash<sph::hash_algorithm::blake2s>(24)
+            .with_blake2s_parameters(sph::blake2s_parameters{ .personal = personal });
+        bool threw{ false };
+        try
+        {
+            auto unused = input | hasher | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    SUBCASE("keyed.verify")
+    {
+        std::array<uint8_t, 32> key{};
+        key.fill(0x5a);
+        std::array<uint8_t, 8> salt{ 's', 'a', 'l', 't', 's', 'a', 'l', 't' };
+        auto const parameters{ sph::blake2s_parameters{ .key = key, .salt = salt } };
+        auto const hash = input
+            | sph::views::hash<sph::hash_algorithm::blake2s>(24).with_blake2s_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        auto const unkeyed = input | sph::views::hash<sph::hash_algorithm::blake2s>(24) | std::ranges::to<std::vector>();
+        CHECK(hash != unkeyed);
+        auto const verify = input
+            | sph::views::hash_verify<sph::hash_algorithm::blake2s>(hash).with_blake2s_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+    }
+}
+
+TEST_CASE("hash.blake2_parallel")
+{
+    // long enough to fill several stripes and end part way through one
+    std::vector<uint8_t> input(5000);
+    std::ranges::copy(std::views::iota(0, 5000) | std::views::transform([](int i) -> uint8_t { return static_cast<uint8_t>(i * 31); }), input.begin());
+
+    SUBCASE("blake2bp.contiguous.matches.streamed")
+    {
+        auto const contiguous = input | sph::views::hash<sph::hash_algorithm::blake2bp>() | std::ranges::to<std::vector>();
+        auto const streamed = input
+            | std::views::transform([](uint8_t v) -> uint8_t { return v; })
+            | sph::views::hash<sph::hash_algorithm::blake2bp>()
+            | std::ranges::to<std::vector>();
+        CHECK(contiguous.size() == 64);
+        CHECK(contiguous == streamed);
+    }
+
+    SUBCASE("blake2sp.contiguous.matches.streamed")
+    {
+        auto const contiguous = input | sph::views::hash<sph::hash_algorithm::blake2sp>() | std::ranges::to<std::vector>();
+        auto const streamed = input
+            | std::views::transform([](uint8_t v) -> uint8_t { return v; })
+            | sph::views::hash<sph::hash_algorithm::blake2sp>()
+            | std::ranges::to<std::vector>();
+        CHECK(contiguous.size() == 32);
+        CHECK(contiguous == streamed);
+    }
+
+    SUBCASE("differs.from.sequential")
+    {
+        auto const parallel = input | sph::views::hash<sph::hash_algorithm::blake2bp>() | std::ranges::to<std::vector>();
+        auto const sequential = input | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>();
+        CHECK(parallel != sequential);
+    }
+
+    SUBCASE("blake2bp.keyed.verify")
+    {
+        std::array<uint8_t, 64> key{};
+        key.fill(0xa5);
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        auto const hash = input
+            | sph::views::hash<sph::hash_algorithm::blake2bp>().with_blake2b_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        auto const verify = input
+            | sph::views::hash_verify<sph::hash_algorithm::blake2bp>(hash).with_blake2b_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+    }
+
+    SUBCASE("blake2sp.oversized.key.rejected")
+    {
+        std::vector<uint8_t> key(33, 0x01);
+        auto hasher = sph::views::hash<sph::hash_algorithm::blake2sp>()
+            .with_blake2s_parameters(sph::blake2s_parameters{ .key = key });
+        bool threw{ false };
+        try
+        {
+            auto unused = input | hasher | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+TEST_CASE("hash.k12")
+{
+    // several full groups of 8192-byte leaves plus a partial leaf
+    std::vector<uint8_t> input(9 * 8192 + 100);
+    std::ranges::copy(std::views::iota(0, static_cast<int>(input.size())) | std::views::transform([](int i) -> uint8_t { return static_cast<uint8_t>(i % 251); }), input.begin());
+    std::array<uint8_t, 5> const customization{ 'a', 'p', 'p', 'I', 'D' };
+
+    SUBCASE("contiguous.matches.streamed")
+    {
+        auto const contiguous = input | sph::views::hash<sph::hash_algorithm::k12>() | std::ranges::to<std::vector>();
+        auto const streamed = input
+            | std::views::transform([](uint8_t v) -> uint8_t { return v; })
+            | sph::views::hash<sph::hash_algorithm::k12>()
+            | std::ranges::to<std::vector>();
+        CHECK(contiguous.size() == 64);
+        CHECK(contiguous == streamed);
+    }
+
+    SUBCASE("shorter.output.is.prefix")
+    {
+        auto const full = input | sph::views::hash<sph::hash_algorithm::k12>() | std::ranges::to<std::vector>();
+        auto const short_hash = input | sph::views::hash<sph::hash_algorithm::k12>(20) | std::ranges::to<std::vector>();
+        CHECK(short_hash.size() == 20);
+        CHECK(std::ranges::equal(short_hash, full | std::views::take(20)));
+    }
+
+    SUBCASE("customization.changes.hash")
+    {
+        auto const plain = input | sph::views::hash<sph::hash_algorithm::k12>(32) | std::ranges::to<std::vector>();
+        auto const customized = input
+            | sph::views::hash<sph::hash_algorithm::k12>(32).with_k12_parameters(sph::k12_parameters{ .customization = customization })
+            | std::ranges::to<std::vector>();
+        CHECK(plain != customized);
+    }
+
+    SUBCASE("customized.verify")
+    {
+        auto const parameters{ sph::k12_parameters{ .customization = customization } };
+        auto const hash = input
+            | sph::views::hash<sph::hash_algorithm::k12>(32).with_k12_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        auto const verify = input
+            | sph::views::hash_verify<sph::hash_algorithm::k12>(hash).with_k12_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+        auto const wrong = input
+            | sph::views::hash_verify<sph::hash_algorithm::k12>(hash)
+            | std::ranges::to<std::vector>();
+        CHECK_FALSE(wrong.front());
+    }
+}
+
+TEST_CASE("hash.shake")
+{
+    std::vector<uint8_t> input(1000);
+    std::ranges::copy(std::views::iota(0, static_cast<int>(input.size())) | std::views::transform([](int i) -> uint8_t { return static_cast<uint8_t>(i % 251); }), input.begin());
+
+    SUBCASE("long.output.is.squeezed.lazily")
+    {
+        // far more output than could ever be buffered; only what is read gets squeezed
+        auto const prefix = input
+            | sph::views::hash<sph::hash_algorithm::shake128>(size_t{ 1 } << 40)
+            | std::views::take(500)
+            | std::ranges::to<std::vector>();
+        auto const exact = input | sph::views::hash<sph::hash_algorithm::shake128>(500) | std::ranges::to<std::vector>();
+        CHECK(prefix.size() == 500);
+        CHECK(prefix == exact);
+    }
+
+    SUBCASE("default.output.is.prefix")
+    {
+        auto const short_hash = input | sph::views::hash<sph::hash_algorithm::shake256>() | std::ranges::to<std::vector>();
+        auto const long_hash = input | sph::views::hash<sph::hash_algorithm::shake256>(3 * 136 + 5) | std::ranges::to<std::vector>();
+        CHECK(short_hash.size() == sph::hash_param<sph::hash_algorithm::shake256>::hash_byte_count());
+        CHECK(long_hash.size() == 3 * 136 + 5);
+        CHECK(std::ranges::equal(short_hash, long_hash | std::views::take(short_hash.size())));
+    }
+
+    SUBCASE("long.output.across.blocks.as.size_t")
+    {
+        auto const bytes = input | sph::views::hash<sph::hash_algorithm::shake128>(40 * sizeof(size_t)) | std::ranges::to<std::vector>();
+        auto const values = input | sph::views::hash<sph::hash_algorithm::shake128, size_t, sph::hash_format::raw>(40 * sizeof(size_t)) | std::ranges::to<std::vector>();
+        CHECK(values.size() == 40);
+        CHECK(hash_to_byte_vector(values) == bytes);
+    }
+
+    SUBCASE("long.output.verify")
+    {
+        auto const hash = input | sph::views::hash<sph::hash_algorithm::shake256>(1000) | std::ranges::to<std::vector>();
+        auto const verify = input | sph::views::hash_verify<sph::hash_algorithm::shake256>(hash) | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+    }
+
+    SUBCASE("oversized.padded.rejected")
+    {
+        bool threw{ false };
+        try
+        {
+            auto unused = input | sph::views::hash<sph::hash_algorithm::shake128, uint8_t, sph::hash_format::padded>(sph::hash_param<sph::hash_algorithm::shake128>::hash_byte_count() + 1) | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    SUBCASE("oversized.append.rejected")
+    {
+        bool threw{ false };
+        try
+        {
+            auto unused = input | sph::views::hash<sph::hash_algorithm::shake256, uint8_t, sph::hash_site::append>(sph::hash_param<sph::hash_algorithm::shake256>::hash_byte_count() + 1) | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+TEST_CASE("hash.parallel_hash")
+{
+    // enough 8192-byte blocks for several thread pool tasks, plus a partial block
+    std::vector<uint8_t> input(300 * 8192 + 100);
+    std::ranges::copy(std::views::iota(0, static_cast<int>(input.size())) | std::views::transform([](int i) -> uint8_t { return static_cast<uint8_t>(i % 251); }), input.begin());
+    std::array<uint8_t, 5> const customization{ 'a', 'p', 'p', 'I', 'D' };
+
+    SUBCASE("contiguous.matches.streamed")
+    {
+        auto const contiguous = input | sph::views::hash<sph::hash_algorithm::parallelhash128>() | std::ranges::to<std::vector>();
+        auto const streamed = input
+            | std::views::transform([](uint8_t v) -> uint8_t { return v; })
+            | sph::views::hash<sph::hash_algorithm::parallelhash128>()
+            | std::ranges::to<std::vector>();
+        CHECK(contiguous.size() == 32);
+        CHECK(contiguous == streamed);
+    }
+
+    SUBCASE("block.size.changes.hash")
+    {
+        auto const default_blocks = input | sph::views::hash<sph::hash_algorithm::parallelhash256>() | std::ranges::to<std::vector>();
+        auto const large_blocks = input
+            | sph::views::hash<sph::hash_algorithm::parallelhash256>().with_parallel_hash_parameters(sph::parallel_hash_parameters{ .block_size = 65536 })
+            | std::ranges::to<std::vector>();
+        CHECK(default_blocks != large_blocks);
+    }
+
+    SUBCASE("output.size.changes.hash")
+    {
+        auto const full = input | sph::views::hash<sph::hash_algorithm::parallelhash128>() | std::ranges::to<std::vector>();
+        auto const short_hash = input | sph::views::hash<sph::hash_algorithm::parallelhash128>(20) | std::ranges::to<std::vector>();
+        CHECK(short_hash.size() == 20);
+        CHECK_FALSE(std::ranges::equal(short_hash, full | std::views::take(20)));
+    }
+
+    SUBCASE("customized.verify")
+    {
+        auto const parameters{ sph::parallel_hash_parameters{ .block_size = 1024, .customization = customization } };
+        auto const hash = input
+            | sph::views::hash<sph::hash_algorithm::parallelhash128>().with_parallel_hash_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        auto const verify = input
+            | sph::views::hash_verify<sph::hash_algorithm::parallelhash128>(hash).with_parallel_hash_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+        auto const wrong = input
+            | sph::views::hash_verify<sph::hash_algorithm::parallelhash128>(hash)
+            | std::ranges::to<std::vector>();
+        CHECK_FALSE(wrong.front());
+    }
+
+    SUBCASE("zero.block.size.rejected")
+    {
+        bool threw{ false };
+        try
+        {
+            auto unused = input
+                | sph::views::hash<sph::hash_algorithm::parallelhash128>().with_parallel_hash_parameters(sph::parallel_hash_parameters{ .block_size = 0 })
+                | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    SUBCASE("thread_pool.nested.run")
+    {
+        // a task that runs the pool again mustn't wait on it
+        sph::ranges::views::detail::thread_pool pool{ 3 };
+        std::vector<size_t> counts(8);
+        pool.run(counts.size(), [&](size_t i) -> void
+            {
+                pool.run(4, [&](size_t) -> void { ++counts[i]; });
+            });
+        CHECK(std::ranges::all_of(counts, [](size_t count) { return count == 4; }));
+    }
+
+    SUBCASE("thread_pool.task.throws")
+    {
+        sph::ranges::views::detail::thread_pool pool{ 3 };
+        bool threw{ false };
+        try
+        {
+            pool.run(100, [](size_t i) -> void
+                {
+                    if (i == 7)
+                    {
+                        throw std::runtime_error("task failed");
+                    }
+                });
+        }
+        catch (std::runtime_error const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        std::vector<uint8_t> ran(100);
+        pool.run(ran.size(), [&](size_t i) -> void { ran[i] = 1; });
+        CHECK(std::ranges::all_of(ran, [](uint8_t v) { return v == 1; }));
+    }
+}
+
+TEST_CASE("hash.sha512_t")
+{
+    std::vector<uint8_t> const input{ 'a', 'b', 'c' };
+
+    SUBCASE("not.truncated.sha512")
+    {
+        auto const truncated = input | sph::views::hash<sph::hash_algorithm::sha512>(32) | std::ranges::to<std::vector>();
+        auto const sha512_256 = input | sph::views::hash<sph::hash_algorithm::sha512_256>() | std::ranges::to<std::vector>();
+        CHECK(sha512_256.size() == 32);
+        CHECK(sha512_256 != truncated);
+    }
+
+    SUBCASE("sha512_224.size")
+    {
+        auto const sha512_224 = input | sph::views::hash<sph::hash_algorithm::sha512_224>() | std::ranges::to<std::vector>();
+        CHECK(sha512_224.size() == 28);
+    }
+}
+
+TEST_CASE("hash.git_object")
+{
+    std::vector<uint8_t> const input{ 'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd' };
+    auto const to_hex{ [](auto const& hash) -> std::string { return fmt::format("{:02x}", fmt::join(hash, "")); } };
+
+    SUBCASE("sha1")
+    {
+        std::vector<uint8_t> const abc{ 'a', 'b', 'c' };
+        auto const hash = abc | sph::views::hash<sph::hash_algorithm::sha1>() | std::ranges::to<std::vector>();
+        CHECK(to_hex(hash) == "a9993e364706816aba3e25717850c26c9cd0d89d");
+    }
+    SUBCASE("blob")
+    {
+        auto const sha1 = input | sph::views::hash<sph::hash_algorithm::git_sha1>() | std::ranges::to<std::vector>();
+        CHECK(to_hex(sha1) == "95d09f2b10159347eece71399a7e2e907ea3df4f");
+        auto const sha256 = input | sph::views::hash<sph::hash_algorithm::git_sha256>() | std::ranges::to<std::vector>();
+        CHECK(to_hex(sha256) == "fee53a18d32820613c0527aa79be5cb30173c823a9b448fa4817767cc84c6f03");
+    }
+    SUBCASE("streamed.matches.contiguous")
+    {
+        auto const contiguous = input | sph::views::hash<sph::hash_algorithm::git_sha1>() | std::ranges::to<std::vector>();
+        auto const streamed = input
+            | std::views::transform([](uint8_t v) -> uint8_t { return v; })
+            | sph::views::hash<sph::hash_algorithm::git_sha1>()
+            | std::ranges::to<std::vector>();
+        CHECK(contiguous == streamed);
+    }
+    SUBCASE("size.in.bytes")
+    {
+        std::vector<uint32_t> const words{ 1, 2, 3 };
+        auto const hash = words | sph::views::hash<sph::hash_algorithm::git_sha1>() | std::ranges::to<std::vector>();
+        CHECK(to_hex(hash) == "9adb25b58c3778fe3473cfc99202646106a02670");
+    }
+    SUBCASE("empty.tree")
+    {
+        std::vector<uint8_t> const empty{};
+        auto const hash = empty
+            | sph::views::hash<sph::hash_algorithm::git_sha1>().with_git_object_parameters(sph::git_object_parameters{ .type = "tree" })
+            | std::ranges::to<std::vector>();
+        CHECK(to_hex(hash) == "4b825dc642cb6eb9a060e54bf8d69288fbee4904");
+    }
+    SUBCASE("verify")
+    {
+        auto const parameters{ sph::git_object_parameters{ .type = "commit" } };
+        auto const hash = input
+            | sph::views::hash<sph::hash_algorithm::git_sha256>().with_git_object_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        auto const verify = input
+            | sph::views::hash_verify<sph::hash_algorithm::git_sha256>(hash).with_git_object_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        CHECK(verify.front());
+        auto const wrong = input
+            | sph::views::hash_verify<sph::hash_algorithm::git_sha256>(hash)
+            | std::ranges::to<std::vector>();
+        CHECK_FALSE(wrong.front());
+    }
+    SUBCASE("unknown.type.rejected")
+    {
+        bool threw{ false };
+        try
+        {
+            auto unused = input
+                | sph::views::hash<sph::hash_algorithm::git_sha1>().with_git_object_parameters(sph::git_object_parameters{ .type = "file" })
+                | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+TEST_CASE("hash.hash_each")
+{
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t size : std::array<size_t, 7>{ 0, 1, 63, 64, 65, 200, 3000 })
+    {
+        messages.push_back(std::views::iota(size_t{ 0 }, size) | std::views::transform([](size_t i) -> uint8_t { return static_cast<uint8_t>(i * 13); }) | std::ranges::to<std::vector>());
+    }
+
+    auto const matches_views{ [&]<sph::hash_algorithm A>(std::vector<uint8_t> const& digests, size_t hash_size) -> bool
+        {
+            auto const expected = messages
+                | std::views::transform([&](std::vector<uint8_t> const& message) { return message | sph::views::hash<A>(hash_size) | std::ranges::to<std::vector>(); })
+                | std::views::join
+                | std::ranges::to<std::vector>();
+            return digests == expected;
+        } };
+
+    SUBCASE("matches.views")
+    {
+        CHECK(matches_views.operator()<sph::hash_algorithm::sha256>(sph::hash_each<sph::hash_algorithm::sha256>(messages), 0));
+        CHECK(matches_views.operator()<sph::hash_algorithm::blake2b>(sph::hash_each<sph::hash_algorithm::blake2b>(messages, 20), 20));
+        CHECK(matches_views.operator()<sph::hash_algorithm::git_sha1>(sph::hash_each<sph::hash_algorithm::git_sha1>(messages), 0));
+        CHECK(matches_views.operator()<sph::hash_algorithm::shake128>(sph::hash_each<sph::hash_algorithm::shake128>(messages, 500), 500));
+    }
+    SUBCASE("into.buffer")
+    {
+        std::vector<uint8_t> digests(messages.size() * 32);
+        CHECK(sph::hash_each<sph::hash_algorithm::sha256>(messages, digests) == messages.size());
+        CHECK(digests == sph::hash_each<sph::hash_algorithm::sha256>(messages));
+    }
+    SUBCASE("non.contiguous.messages")
+    {
+        auto const streamed = messages
+            | std::views::transform([](std::vector<uint8_t> const& message) { return message | std::views::transform([](uint8_t v) -> uint8_t { return v; }); });
+        CHECK(sph::hash_each<sph::hash_algorithm::sha3_256>(streamed) == sph::hash_each<sph::hash_algorithm::sha3_256>(messages));
+    }
+    SUBCASE("parameters")
+    {
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        auto const digests = sph::hash_each<sph::hash_algorithm::blake2b>(messages, 0, parameters);
+        auto const expected = messages
+            | std::views::transform([&](std::vector<uint8_t> const& message) { return message | sph::views::hash<sph::hash_algorithm::blake2b>().with_blake2b_parameters(parameters) | std::ranges::to<std::vector>(); })
+            | std::views::join
+            | std::ranges::to<std::vector>();
+        CHECK(digests == expected);
+    }
+    SUBCASE("buffer.too.small")
+    {
+        std::vector<uint8_t> digests(32 * 2);
+        bool threw{ false };
+        try
+        {
+            sph::hash_each<sph::hash_algorithm::sha256>(messages, digests);
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(std::ranges::all_of(digests, [](uint8_t v) { return v == 0; }));
+    }
+}
+
+TEST_CASE("hash.hash_each_parallel")
+{
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        messages.push_back(std::views::iota(size_t{ 0 }, (i * 37) % 700) | std::views::transform([i](size_t j) -> uint8_t { return static_cast<uint8_t>(i + (j * 13)); }) | std::ranges::to<std::vector>());
+    }
+
+    SUBCASE("matches.serial")
+    {
+        CHECK(sph::hash_each_parallel<sph::hash_algorithm::sha256>(messages) == sph::hash_each<sph::hash_algorithm::sha256>(messages));
+        CHECK(sph::hash_each_parallel<sph::hash_algorithm::blake2b>(messages, 20) == sph::hash_each<sph::hash_algorithm::blake2b>(messages, 20));
+        CHECK(sph::hash_each_parallel<sph::hash_algorithm::git_sha1>(messages) == sph::hash_each<sph::hash_algorithm::git_sha1>(messages));
+    }
+    SUBCASE("nested.parallel_hash")
+    {
+        // messages over 256 KiB make ParallelHash run the shared pool from
+        // inside a task on the same pool
+        std::vector<std::vector<uint8_t>> large_messages;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            large_messages.push_back(std::views::iota(size_t{ 0 }, (300 * 1024) + (i * 8192)) | std::views::transform([i](size_t j) -> uint8_t { return static_cast<uint8_t>(i + (j * 7)); }) | std::ranges::to<std::vector>());
+        }
+
+        CHECK(sph::hash_each_parallel<sph::hash_algorithm::parallelhash128>(large_messages) == sph::hash_each<sph::hash_algorithm::parallelhash128>(large_messages));
+    }
+    SUBCASE("worker.threads")
+    {
+        sph::ranges::views::detail::thread_pool pool{ 3 };
+        for (size_t hash_size : std::array<size_t, 4>{ 1, 20, 32, 48 })
+        {
+            sph::ranges::views::detail::batch_hasher<sph::hash_algorithm::blake2b> const hasher{ hash_size };
+            std::vector<uint8_t> digests(messages.size() * hash_size);
+            CHECK(sph::ranges::views::detail::hash_each_parallel_into<sph::hash_algorithm::blake2b>(messages, digests, hasher, pool) == messages.size());
+            CHECK(digests == sph::hash_each<sph::hash_algorithm::blake2b>(messages, hash_size));
+
+            // split points follow the buffer's address, not its start
+            for (size_t offset : std::array<size_t, 3>{ 1, 8, 16 })
+            {
+                std::vector<uint8_t> shifted(offset + digests.size());
+                CHECK(sph::ranges::views::detail::hash_each_parallel_into<sph::hash_algorithm::blake2b>(messages, std::span{ shifted }.subspan(offset), hasher, pool) == messages.size());
+                CHECK(std::ranges::equal(shifted | std::views::drop(offset), digests));
+            }
+        }
+    }
+    SUBCASE("parameters")
+    {
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        CHECK(sph::hash_each_parallel<sph::hash_algorithm::blake2b>(messages, 0, parameters) == sph::hash_each<sph::hash_algorithm::blake2b>(messages, 0, parameters));
+    }
+    SUBCASE("buffer.too.small")
+    {
+        std::vector<uint8_t> digests((messages.size() - 1) * 32);
+        bool threw{ false };
+        try
+        {
+            sph::hash_each_parallel<sph::hash_algorithm::sha256>(messages, digests);
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(std::ranges::all_of(digests, [](uint8_t v) { return v == 0; }));
+    }
+}
+
+TEST_CASE("hash.verify_each")
+{
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        messages.push_back(std::views::iota(size_t{ 0 }, (i * 29) % 300) | std::views::transform([i](size_t j) -> uint8_t { return static_cast<uint8_t>(i ^ (j * 7)); }) | std::ranges::to<std::vector>());
+    }
+
+    auto digests{ sph::hash_each<sph::hash_algorithm::sha256>(messages) };
+    SUBCASE("all.pass")
+    {
+        auto const result{ sph::verify_each<sph::hash_algorithm::sha256>(messages, digests | std::views::chunk(32)) };
+        CHECK(result.all_passed());
+        CHECK(result.count == messages.size());
+        CHECK(result.passed_bits.size() == 2);
+        CHECK(std::ranges::all_of(std::views::iota(size_t{ 0 }, messages.size()), [&](size_t i) { return result.passed(i); }));
+    }
+    SUBCASE("failures.reported")
+    {
+        digests[(3 * 32) + 5] ^= 0x01;
+        digests[(70 * 32) + 31] ^= 0x80;
+        auto const result{ sph::verify_each<sph::hash_algorithm::sha256>(messages, digests | std::views::chunk(32)) };
+        CHECK_FALSE(result.all_passed());
+        CHECK(result.first_failure == 3);
+        CHECK(result.count == messages.size());
+        CHECK_FALSE(result.passed(3));
+        CHECK_FALSE(result.passed(70));
+        CHECK(std::ranges::count_if(std::views::iota(size_t{ 0 }, messages.size()), [&](size_t i) { return result.passed(i); }) == 98);
+    }
+    SUBCASE("stop.at.first.failure")
+    {
+        digests[(3 * 32) + 5] ^= 0x01;
+        digests[(70 * 32) + 31] ^= 0x80;
+        auto const result{ sph::verify_each<sph::hash_algorithm::sha256>(messages, digests | std::views::chunk(32), 0, sph::verify_each_mode::stop_at_first_failure) };
+        CHECK(result.first_failure == 3);
+        CHECK(result.count == 4);
+        CHECK(result.passed(2));
+        CHECK_FALSE(result.passed(3));
+        CHECK_FALSE(result.passed(4));
+    }
+    SUBCASE("truncated.digests")
+    {
+        auto const truncated{ sph::hash_each<sph::hash_algorithm::sha256>(messages, 16) };
+        CHECK(sph::verify_each<sph::hash_algorithm::sha256>(messages, truncated | std::views::chunk(16), 16).all_passed());
+        auto const result{ sph::verify_each<sph::hash_algorithm::sha256>(messages, truncated | std::views::chunk(16)) };
+        CHECK(result.first_failure == 0);
+        CHECK(result.passed_bits == std::vector<uint64_t>{ 0, 0 });
+    }
+    SUBCASE("parameters")
+    {
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        auto const tags{ sph::hash_each<sph::hash_algorithm::blake2b>(messages, 0, parameters) };
+        CHECK(sph::verify_each<sph::hash_algorithm::blake2b>(messages, tags | std::views::chunk(64), 0, parameters).all_passed());
+        CHECK_FALSE(sph::verify_each<sph::hash_algorithm::blake2b>(messages, tags | std::views::chunk(64)).passed(0));
+    }
+    SUBCASE("count.mismatch.rejected")
+    {
+        bool threw{ false };
+        try
+        {
+            sph::verify_each<sph::hash_algorithm::sha256>(messages, digests | std::views::chunk(32) | std::views::take(99));
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+TEST_CASE("hash.digest")
+{
+    using sha256_digest = sph::digest<sph::hash_algorithm::sha256>;
+    static_assert(sizeof(sha256_digest) == 32);
+    static_assert(sizeof(sph::digest<sph::hash_algorithm::blake2b, 20>) == 20);
+    static_assert(std::is_trivially_copyable_v<sha256_digest>);
+    std::vector<uint8_t> const message{ 'h', 'e', 'l', 'l', 'o' };
+    auto const expected = message | sph::views::hash<sph::hash_algorithm::sha256>() | std::ranges::to<std::vector>();
+    SUBCASE("hash_digest")
+    {
+        auto const value{ sph::hash_digest<sph::hash_algorithm::sha256>(message) };
+        CHECK(std::ranges::equal(value, expected));
+        CHECK(value == sha256_digest{ std::span<uint8_t const, 32>{ expected } });
+        auto const truncated{ sph::hash_digest<sph::hash_algorithm::sha256, 12>(message) };
+        CHECK(std::ranges::equal(truncated, std::span{ expected }.first(12)));
+    }
+    SUBCASE("compare")
+    {
+        auto const value{ sph::hash_digest<sph::hash_algorithm::sha256>(message) };
+        for (size_t i : std::array<size_t, 4>{ 0, 7, 8, 31 })
+        {
+            auto changed{ value };
+            changed[i] ^= 0x01;
+            CHECK(changed != value);
+            CHECK(((changed < value) == (changed[i] < value[i])));
+        }
+        CHECK((value <=> value) == std::strong_ordering::equal);
+        auto const odd{ sph::hash_digest<sph::hash_algorithm::blake2b, 13>(message) };
+        auto changed_odd{ odd };
+        changed_odd[12] ^= 0x80;
+        CHECK(changed_odd != odd);
+    }
+    SUBCASE("prefix")
+    {
+        auto const value{ sph::hash_digest<sph::hash_algorithm::sha256>(message) };
+        uint64_t prefix{};
+        std::memcpy(&prefix, expected.data(), sizeof(prefix));
+        CHECK(value.prefix() == prefix);
+        CHECK(std::hash<sha256_digest>{}(value) == std::hash<uint64_t>{}(prefix));
+        auto const short_value{ sph::hash_digest<sph::hash_algorithm::sha256, 3>(message) };
+        CHECK(short_value.prefix() == (prefix & 0xFFFFFF));
+    }
+    SUBCASE("hash_each")
+    {
+        std::vector<std::vector<uint8_t>> messages;
+        for (size_t i = 0; i < 50; ++i)
+        {
+            messages.push_back(std::vector<uint8_t>(i * 11, static_cast<uint8_t>(i)));
+        }
+
+        auto const digests{ sph::hash_each<sph::hash_algorithm::sha256, 32>(messages) };
+        REQUIRE(digests.size() == messages.size());
+        CHECK(std::ranges::equal(digests | std::views::join, sph::hash_each<sph::hash_algorithm::sha256>(messages)));
+        std::unordered_set<sha256_digest> const unique(digests.begin(), digests.end());
+        CHECK(unique.size() == messages.size());
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        auto const tags{ sph::hash_each<sph::hash_algorithm::blake2b, 16>(messages, parameters) };
+        CHECK(std::ranges::equal(tags | std::views::join, sph::hash_each<sph::hash_algorithm::blake2b>(messages, 16, parameters)));
+        CHECK(tags[3] == sph::hash_digest<sph::hash_algorithm::blake2b, 16>(messages[3], parameters));
+    }
+}
+
+TEST_CASE("hash.hash_to")
+{
+    std::vector<uint8_t> const message{ 'h', 'e', 'l', 'l', 'o' };
+    SUBCASE("uint64_t")
+    {
+        auto const expected{ sph::hash_digest<sph::hash_algorithm::blake2b, 8>(message) };
+        uint64_t value{};
+        std::memcpy(&value, expected.data(), sizeof(value));
+        CHECK(sph::hash_to<uint64_t>(message) == value);
+        CHECK(sph::hash_to<uint64_t, sph::hash_algorithm::blake2b>(std::span<uint8_t const>{ message }) == value);
+        CHECK(sph::hash_to<uint64_t>(message | std::views::transform([](uint8_t c) { return c; })) == value);
+        CHECK(sph::hash_to<uint32_t, sph::hash_algorithm::sha256>(message) == sph::hash_digest<sph::hash_algorithm::sha256>(message).prefix() % (uint64_t{ 1 } << 32));
+    }
+    SUBCASE("128.bits")
+    {
+        auto const expected{ sph::hash_digest<sph::hash_algorithm::sha256, 16>(message) };
+        auto const value{ sph::hash_to<std::array<uint64_t, 2>, sph::hash_algorithm::sha256>(message) };
+        CHECK(std::memcmp(value.data(), expected.data(), 16) == 0);
+    }
+    SUBCASE("parameters")
+    {
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::siphash_parameters{ .key = key } };
+        auto const expected{ sph::hash_digest<sph::hash_algorithm::siphash24, 8>(message, parameters) };
+        CHECK(sph::hash_to<uint64_t, sph::hash_algorithm::siphash24>(message, parameters) == expected.prefix());
+    }
+    SUBCASE("lengths")
+    {
+        // either side of the one-chunk short-input path
+        for (size_t size : std::array<size_t, 6>{ 0, 1, 127, 128, 129, 300 })
+        {
+            std::vector<uint16_t> const words(size, static_cast<uint16_t>(size));
+            auto const expected{ sph::hash_digest<sph::hash_algorithm::blake2b, 8>(words) };
+            CHECK(sph::hash_to<uint64_t>(words | std::views::transform([](uint16_t w) { return w; })) == expected.prefix());
+        }
+    }
+}
+
+TEST_CASE("hash.text_format")
+{
+    std::string const abc{ "abc" };
+    std::string const sha256_hex{ "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" };
+    SUBCASE("hex")
+    {
+        CHECK((abc | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_format::hex>() | std::ranges::to<std::string>()) == sha256_hex);
+        auto upper{ sha256_hex };
+        std::ranges::transform(upper, upper.begin(), [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+        CHECK((abc | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_format::hex_upper>() | std::ranges::to<std::string>()) == upper);
+        CHECK((abc | sph::views::hash<sph::hash_algorithm::sha256, char, sph::hash_format::hex>(5) | std::ranges::to<std::string>()) == sha256_hex.substr(0, 10));
+        CHECK((abc | sph::views::hash<sph::hash_algorithm::blake2b, sph::hash_format::hex>(20) | std::ranges::to<std::string>()) == "384264f676f39536840523f284921cdc68b6846b");
+    }
+    SUBCASE("base64url")
+    {
+        CHECK((abc | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_format::base64url>() | std::ranges::to<std::string>()) == "ungWv48Bz-pBQUDeXa4iI7ADYaOWF3qctBD_YfIAFa0");
+        CHECK((abc | sph::views::hash<sph::hash_algorithm::blake2b, sph::hash_format::base64url>(20) | std::ranges::to<std::string>()) == "OEJk9nbzlTaEBSPyhJIc3Gi2hGs");
+    }
+    SUBCASE("matches.raw")
+    {
+        // every length, for both partial hex words and base64 tails
+        for (size_t size = 1; size <= 64; ++size)
+        {
+            auto const raw = abc | sph::views::hash<sph::hash_algorithm::blake2b>(size) | std::ranges::to<std::vector>();
+            std::string expected;
+            for (auto b : raw)
+            {
+                expected += std::format("{:02x}", b);
+            }
+
+            CHECK((abc | sph::views::hash<sph::hash_algorithm::blake2b, sph::hash_format::hex>(size) | std::ranges::to<std::string>()) == expected);
+            auto const base64 = abc | sph::views::hash<sph::hash_algorithm::blake2b, sph::hash_format::base64url>(size) | std::ranges::to<std::string>();
+            CHECK(base64.size() == (size * 4 + 2) / 3);
+        }
+
+        std::string shake;
+        for (auto b : abc | sph::views::hash<sph::hash_algorithm::shake128>())
+        {
+            shake += std::format("{:02x}", b);
+        }
+
+        CHECK((abc | sph::views::hash<sph::hash_algorithm::shake128, sph::hash_format::hex>() | std::ranges::to<std::string>()) == shake);
+    }
+    SUBCASE("append")
+    {
+        auto const appended = abc | sph::views::hash<sph::hash_algorithm::sha256, char, sph::hash_format::hex, sph::hash_site::append>() | std::ranges::to<std::string>();
+        CHECK(appended == abc + sha256_hex);
+        CHECK(*std::ranges::begin(appended | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex>()));
+        auto changed{ appended };
+        changed[1] = 'B';
+        CHECK_FALSE(*std::ranges::begin(changed | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex>()));
+    }
+    SUBCASE("verify")
+    {
+        CHECK(*std::ranges::begin(abc | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex>(sha256_hex)));
+        auto upper{ sha256_hex };
+        std::ranges::transform(upper, upper.begin(), [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+        CHECK(*std::ranges::begin(abc | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex>(upper)));
+        CHECK(*std::ranges::begin(abc | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex>(sha256_hex.substr(0, 16))));
+        CHECK(*std::ranges::begin(abc | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::base64url>(std::string{ "ungWv48Bz-pBQUDeXa4iI7ADYaOWF3qctBD_YfIAFa0" })));
+        CHECK_FALSE(*std::ranges::begin(abc | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::base64url>(std::string{ "ungWv48Bz-pBQUDeXa4iI7ADYaOWF3qctBD_YfIAFa1" })));
+        CHECK_FALSE(*std::ranges::begin(abc | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex>(sha256_hex.substr(0, 63))));
+        auto bad_digit{ sha256_hex };
+        bad_digit[10] = 'g';
+        CHECK_FALSE(*std::ranges::begin(abc | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex>(bad_digit)));
+        auto changed{ sha256_hex };
+        changed[63] = 'c';
+        CHECK_FALSE(*std::ranges::begin(abc | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex>(changed)));
+    }
+}
+
+TEST_CASE("hash.decode_input")
+{
+    // sizes around the blake2b and sha256 chunk sizes and the 4-byte hex words
+    for (size_t size : std::array<size_t, 12>{ 0, 1, 2, 3, 5, 63, 64, 65, 127, 128, 129, 300 })
+    {
+        std::vector<uint8_t> bytes(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+        }
+
+        std::string hex;
+        for (auto b : bytes)
+        {
+            hex += std::format("{:02X}", b);
+        }
+
+        std::string base64(sph::ranges::views::detail::encoded_size<sph::hash_format::base64url>(size), '\0');
+        sph::ranges::views::detail::encode_text<sph::hash_format::base64url>(bytes, reinterpret_cast<uint8_t*>(base64.data()));
+        auto const blake2b = bytes | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>();
+        auto const sha256 = bytes | sph::views::hash<sph::hash_algorithm::sha256>() | std::ranges::to<std::vector>();
+        CHECK((hex | sph::views::decode<sph::hash_format::hex>() | std::ranges::to<std::vector>()) == bytes);
+        CHECK((base64 | sph::views::decode<sph::hash_format::base64url>() | std::ranges::to<std::vector>()) == bytes);
+
+        // contiguous text goes through the chunk decoder
+        CHECK((hex | sph::views::decode<sph::hash_format::hex>() | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>()) == blake2b);
+        CHECK((base64 | sph::views::decode<sph::hash_format::base64url>() | sph::views::hash<sph::hash_algorithm::sha256>() | std::ranges::to<std::vector>()) == sha256);
+        CHECK(sph::hash_to<uint64_t>(base64 | sph::views::decode<sph::hash_format::base64url>()) == sph::hash_to<uint64_t>(bytes));
+
+        // anything else is decoded a quantum at a time
+        std::deque<char> const hex_deque(hex.begin(), hex.end());
+        std::deque<char> const base64_deque(base64.begin(), base64.end());
+        CHECK((hex_deque | sph::views::decode<sph::hash_format::hex>() | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>()) == blake2b);
+        CHECK((base64_deque | sph::views::decode<sph::hash_format::base64url>() | sph::views::hash<sph::hash_algorithm::sha256>() | std::ranges::to<std::vector>()) == sha256);
+    }
+
+    SUBCASE("base64.standard")
+    {
+        std::string const text{ "+/+/ab==" };
+        std::vector<uint8_t> const bytes{ 0xFB, 0xFF, 0xBF, 0x69 };
+        CHECK((text | sph::views::decode<sph::hash_format::base64url>() | std::ranges::to<std::vector>()) == bytes);
+        CHECK((text | sph::views::decode<sph::hash_format::base64url>() | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>())
+            == (bytes | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>()));
+    }
+
+    SUBCASE("invalid.rejected")
+    {
+        auto const throws{ []<sph::hash_format F>(std::string const& text) -> bool
+            {
+                try
+                {
+                    auto unused = text | sph::views::decode<F>() | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>();
+                    (void)unused;
+                }
+                catch (std::invalid_argument const&)
+                {
+                    return true;
+                }
+
+                return false;
+            } };
+        CHECK(throws.operator()<sph::hash_format::hex>("abc"));
+        CHECK(throws.operator()<sph::hash_format::hex>("0123456789abcdeg"));
+        CHECK(throws.operator()<sph::hash_format::hex>("0x"));
+        CHECK(throws.operator()<sph::hash_format::base64url>("QUJDR"));
+        CHECK(throws.operator()<sph::hash_format::base64url>("QU.D"));
+    }
+}
+
+TEST_CASE("hash.fixed_size")
+{
+    std::vector<uint8_t> const message{ 'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd' };
+    SUBCASE("matches.runtime.size")
+    {
+        auto const sha256 = message | sph::views::hash<sph::hash_algorithm::sha256, 32>();
+        static_assert(std::is_same_v<decltype(sha256), sph::digest<sph::hash_algorithm::sha256, 32> const>);
+        static_assert(decltype(sha256.bytes())::extent == 32);
+        CHECK(std::ranges::equal(sha256, message | sph::views::hash<sph::hash_algorithm::sha256>()));
+        CHECK(std::ranges::equal(message | sph::views::hash<sph::hash_algorithm::blake2b, 20>(), message | sph::views::hash<sph::hash_algorithm::blake2b>(20)));
+        CHECK(std::ranges::equal(message | sph::views::hash<sph::hash_algorithm::shake128, 100>(), message | sph::views::hash<sph::hash_algorithm::shake128>(100)));
+        CHECK(std::ranges::equal(message | sph::views::hash<sph::hash_algorithm::git_sha1, 20>(), message | sph::views::hash<sph::hash_algorithm::git_sha1>()));
+        CHECK(std::ranges::equal(message | sph::views::hash<sph::hash_algorithm::sha512, 24>() | std::ranges::to<std::vector>(), message | sph::views::hash<sph::hash_algorithm::sha512>(24) | std::ranges::to<std::vector>()));
+    }
+    SUBCASE("parameters")
+    {
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        auto const tag = message | sph::views::hash<sph::hash_algorithm::blake2b, 16>().with_blake2b_parameters(parameters);
+        CHECK(std::ranges::equal(tag, message | sph::views::hash<sph::hash_algorithm::blake2b>(16).with_blake2b_parameters(parameters)));
+        CHECK(*std::ranges::begin(message | sph::views::hash_verify<sph::hash_algorithm::blake2b>(tag).with_blake2b_parameters(parameters)));
+        CHECK_FALSE(*std::ranges::begin(message | sph::views::hash_verify<sph::hash_algorithm::blake2b>(tag)));
+    }
+    SUBCASE("verify")
+    {
+        auto digest = message | sph::views::hash<sph::hash_algorithm::sha256, 32>();
+        CHECK(*std::ranges::begin(message | sph::views::hash_verify<sph::hash_algorithm::sha256>(digest)));
+        auto const truncated = message | sph::views::hash<sph::hash_algorithm::sha256, 12>();
+        CHECK(*std::ranges::begin(message | sph::views::hash_verify<sph::hash_algorithm::sha256>(truncated)));
+        auto changed{ message };
+        changed.back() ^= 0x01;
+        CHECK_FALSE(*std::ranges::begin(changed | sph::views::hash_verify<sph::hash_algorithm::sha256>(digest)));
+        digest[31] ^= 0x01;
+        CHECK_FALSE(*std::ranges::begin(message | sph::views::hash_verify<sph::hash_algorithm::sha256>(digest)));
+    }
+}
+
+TEST_CASE("hash.digest_sink")
+{
+    std::vector<uint8_t> const message{ 'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd' };
+    SUBCASE("raw")
+    {
+        std::array<uint8_t, 32> sink{};
+        auto const appended = message
+            | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_site::append>().with_digest_sink(sink)
+            | std::ranges::to<std::vector>();
+        CHECK(std::ranges::equal(sink, std::span{ appended }.last(32)));
+        CHECK(std::ranges::equal(sink, message | sph::views::hash<sph::hash_algorithm::sha256>()));
+    }
+    SUBCASE("digest")
+    {
+        sph::digest<sph::hash_algorithm::blake2b, 20> sink;
+        auto const appended = message
+            | sph::views::hash<sph::hash_algorithm::blake2b, sph::hash_site::append>(20).with_digest_sink(sink)
+            | std::ranges::to<std::vector>();
+        CHECK(sink == sph::hash_digest<sph::hash_algorithm::blake2b, 20>(message));
+        CHECK(std::ranges::equal(sink, std::span{ appended }.last(20)));
+    }
+    SUBCASE("padded.and.text")
+    {
+        std::array<uint8_t, 32> padded_sink{};
+        auto const padded = message
+            | sph::views::hash<sph::hash_algorithm::sha256, uint32_t, sph::hash_format::padded, sph::hash_site::append>().with_digest_sink(padded_sink)
+            | std::ranges::to<std::vector>();
+        CHECK_FALSE(padded.empty());
+        CHECK(std::ranges::equal(padded_sink, message | sph::views::hash<sph::hash_algorithm::sha256>()));
+        std::array<uint8_t, 32> text_sink{};
+        auto const text = message
+            | sph::views::hash<sph::hash_algorithm::sha256, char, sph::hash_format::hex, sph::hash_site::append>().with_digest_sink(text_sink)
+            | std::ranges::to<std::string>();
+        CHECK(text.size() == message.size() + 64);
+        CHECK(std::ranges::equal(text_sink, message | sph::views::hash<sph::hash_algorithm::sha256>()));
+    }
+    SUBCASE("wrong.size.rejected")
+    {
+        std::array<uint8_t, 16> sink{};
+        bool threw{ false };
+        try
+        {
+            auto unused = sph::views::hash<sph::hash_algorithm::sha256, sph::hash_site::append>().with_digest_sink(sink);
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+TEST_CASE("hasher")
+{
+    std::vector<uint8_t> message(1000);
+    for (size_t i = 0; i < message.size(); ++i)
+    {
+        message[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    // feeds the message in pieces of the given size
+    auto const push{ []<sph::hash_algorithm A>(sph::hasher<A> hasher, std::span<uint8_t const> input, size_t piece) -> std::vector<uint8_t>
+        {
+            for (; input.size() > piece; input = input.subspan(piece))
+            {
+                hasher.update(input.first(piece));
+            }
+
+            hasher.update(input);
+            return hasher.finalize();
+        } };
+    SUBCASE("matches.view")
+    {
+        for (size_t piece : std::array<size_t, 8>{ 1, 3, 63, 64, 65, 128, 129, 1000 })
+        {
+            CHECK(push(sph::hasher<sph::hash_algorithm::blake2b>{}, message, piece) == (message | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>()));
+            CHECK(push(sph::hasher<sph::hash_algorithm::sha256>{}, message, piece) == (message | sph::views::hash<sph::hash_algorithm::sha256>() | std::ranges::to<std::vector>()));
+            CHECK(push(sph::hasher<sph::hash_algorithm::blake2bp>{}, message, piece) == (message | sph::views::hash<sph::hash_algorithm::blake2bp>() | std::ranges::to<std::vector>()));
+            CHECK(push(sph::hasher<sph::hash_algorithm::shake128>{ 100 }, message, piece) == (message | sph::views::hash<sph::hash_algorithm::shake128>(100) | std::ranges::to<std::vector>()));
+            CHECK(push(sph::hasher<sph::hash_algorithm::sha512>{ 24 }, message, piece) == (message | sph::views::hash<sph::hash_algorithm::sha512>(24) | std::ranges::to<std::vector>()));
+        }
+
+        sph::hasher<sph::hash_algorithm::sha256> empty;
+        CHECK(empty.finalize() == (std::vector<uint8_t>{} | sph::views::hash<sph::hash_algorithm::sha256>() | std::ranges::to<std::vector>()));
+    }
+    SUBCASE("element.types")
+    {
+        std::string const text{ "hello world" };
+        std::vector<uint32_t> const words{ 0x01020304, 0x05060708 };
+        sph::hasher<sph::hash_algorithm::sha256> hasher;
+        hasher.update(text);
+        hasher.update(words);
+        std::vector<uint8_t> bytes(text.begin(), text.end());
+        bytes.resize(bytes.size() + sizeof(uint32_t) * words.size());
+        std::memcpy(bytes.data() + text.size(), words.data(), sizeof(uint32_t) * words.size());
+        CHECK(hasher.finalize_digest() == sph::hash_digest<sph::hash_algorithm::sha256>(bytes));
+    }
+    SUBCASE("parameters")
+    {
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        CHECK(push(sph::hasher<sph::hash_algorithm::blake2b>{ 16, parameters }, message, 100)
+            == (message | sph::views::hash<sph::hash_algorithm::blake2b>(16).with_blake2b_parameters(parameters) | std::ranges::to<std::vector>()));
+        CHECK(push(sph::hasher<sph::hash_algorithm::git_sha1>{ message.size() }, message, 100)
+            == (message | sph::views::hash<sph::hash_algorithm::git_sha1>() | std::ranges::to<std::vector>()));
+    }
+    SUBCASE("misuse.rejected")
+    {
+        sph::hasher<sph::hash_algorithm::sha256> hasher;
+        hasher.update(message);
+        std::array<uint8_t, 16> small{};
+        bool threw{ false };
+        try
+        {
+            hasher.finalize_into(small);
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        (void)hasher.finalize();
+        threw = false;
+        try
+        {
+            hasher.update(message);
+        }
+        catch (std::runtime_error const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        sph::hasher<sph::hash_algorithm::git_sha1> git{ message.size() };
+        git.update(std::span{ message }.first(10));
+        threw = false;
+        try
+        {
+            (void)git.finalize();
+        }
+        catch (std::runtime_error const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+TEST_CASE("hash_output_iterator")
+{
+    std::vector<uint8_t> message(1000);
+    for (size_t i = 0; i < message.size(); ++i)
+    {
+        message[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    auto const expected = message | sph::views::hash<sph::hash_algorithm::sha256>() | std::ranges::to<std::vector>();
+    SUBCASE("block.copy")
+    {
+        sph::hasher<sph::hash_algorithm::sha256> hasher;
+        std::vector<uint8_t> copy(message.size());
+        auto const [in, out] { sph::ranges::copy(message, sph::hash_output_iterator{ copy.begin(), hasher }) };
+        CHECK(in == message.end());
+        CHECK(out.base() == copy.end());
+        CHECK(copy == message);
+        CHECK(hasher.finalize() == expected);
+    }
+    SUBCASE("element.copy")
+    {
+        sph::hasher<sph::hash_algorithm::sha256> hasher;
+        std::vector<uint8_t> copy;
+        std::ranges::copy(message | std::views::transform([](uint8_t v) -> uint8_t { return v; }), sph::hash_output_iterator{ std::back_inserter(copy), hasher });
+        CHECK(copy == message);
+        CHECK(hasher.finalize() == expected);
+    }
+    SUBCASE("std.copy")
+    {
+        sph::hasher<sph::hash_algorithm::blake2b> hasher;
+        std::vector<uint32_t> const words{ 1, 2, 3, 0x01020304 };
+        std::vector<uint32_t> copy(words.size());
+        std::copy(words.begin(), words.end(), sph::hash_output_iterator{ copy.begin(), hasher });
+        CHECK(copy == words);
+        CHECK(hasher.finalize() == (words | sph::views::hash<sph::hash_algorithm::blake2b>() | std::ranges::to<std::vector>()));
+    }
+    SUBCASE("post.increment.write")
+    {
+        sph::hasher<sph::hash_algorithm::sha256> hasher;
+        std::vector<uint8_t> copy(message.size());
+        auto it{ sph::hash_output_iterator{ copy.begin(), hasher } };
+        for (auto const v : message)
+        {
+            *it++ = v;
+        }
+
+        CHECK(it.base() == copy.end());
+        CHECK(copy == message);
+        CHECK(hasher.finalize() == expected);
+    }
+}
+
+TEST_CASE("copy_hash")
+{
+    // larger than every algorithm's copy block, and not a whole number of them
+    std::vector<uint8_t> message(40000);
+    for (size_t i = 0; i < message.size(); ++i)
+    {
+        message[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    SUBCASE("separate")
+    {
+        std::vector<uint8_t> output(message.size());
+        std::array<uint8_t, 32> digest{};
+        CHECK(sph::copy_hash<sph::hash_algorithm::sha256>(message, output, digest) == message.size());
+        CHECK(output == message);
+        CHECK(std::ranges::equal(digest, message | sph::views::hash<sph::hash_algorithm::sha256>()));
+        CHECK(sph::copy_hash<sph::hash_algorithm::blake2bp>(message, output, digest) == message.size());
+        CHECK(std::ranges::equal(digest, message | sph::views::hash<sph::hash_algorithm::blake2bp>(32)));
+        std::array<uint8_t, 100> long_digest{};
+        sph::copy_hash<sph::hash_algorithm::shake128>(message, output, long_digest);
+        CHECK(std::ranges::equal(long_digest, message | sph::views::hash<sph::hash_algorithm::shake128>(100)));
+        std::array<uint8_t, 20> git_digest{};
+        sph::copy_hash<sph::hash_algorithm::git_sha1>(message, output, git_digest);
+        CHECK(std::ranges::equal(git_digest, message | sph::views::hash<sph::hash_algorithm::git_sha1>()));
+    }
+    SUBCASE("append")
+    {
+        auto const expected = message | sph::views::hash<sph::hash_algorithm::blake2b, sph::hash_site::append>() | std::ranges::to<std::vector>();
+        std::vector<uint8_t> output(expected.size() + 10);
+        CHECK(sph::copy_hash<sph::hash_algorithm::blake2b, sph::hash_site::append>(message, output) == expected.size());
+        CHECK(std::ranges::equal(std::span{ output }.first(expected.size()), expected));
+        CHECK(*std::ranges::begin(std::span{ output }.first(expected.size()) | sph::views::hash_verify<sph::hash_algorithm::blake2b>(64)));
+    }
+    SUBCASE("parameters")
+    {
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        std::vector<uint8_t> output(message.size() + 16);
+        CHECK(sph::copy_hash<sph::hash_algorithm::blake2b, sph::hash_site::append>(message, output, 16, parameters) == output.size());
+        CHECK(output == (message | sph::views::hash<sph::hash_algorithm::blake2b, sph::hash_site::append>(16).with_blake2b_parameters(parameters) | std::ranges::to<std::vector>()));
+    }
+    SUBCASE("output.too.small")
+    {
+        std::vector<uint8_t> output(message.size());
+        bool threw{ false };
+        try
+        {
+            sph::copy_hash<sph::hash_algorithm::sha256, sph::hash_site::append>(message, output);
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(std::ranges::all_of(output, [](uint8_t v) { return v == 0; }));
+    }
+}
+
+TEST_CASE("hash_verify_payload")
+{
+    // several rolling buffers long, so most of the payload streams through
+    std::vector<uint8_t> message(1000);
+    for (size_t i = 0; i < message.size(); ++i)
+    {
+        message[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    auto const appended = message
+        | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_site::append>(24)
+        | std::ranges::to<std::vector>();
+    SUBCASE("payload")
+    {
+        auto const payload = appended
+            | sph::views::hash_verify_payload<sph::hash_algorithm::sha256>(24)
+            | std::ranges::to<std::vector>();
+        CHECK(payload == message);
+        CHECK(*std::ranges::begin(appended | sph::views::hash_verify<sph::hash_algorithm::sha256>(24)));
+    }
+    SUBCASE("mismatch.throws")
+    {
+        for (size_t position : std::array<size_t, 3>{ 0, message.size(), appended.size() - 1 })
+        {
+            auto changed{ appended };
+            changed[position] ^= 0x01;
+            bool threw{ false };
+            try
+            {
+                auto unused = changed
+                    | sph::views::hash_verify_payload<sph::hash_algorithm::sha256>(24)
+                    | std::ranges::to<std::vector>();
+                (void)unused;
+            }
+            catch (std::runtime_error const&)
+            {
+                threw = true;
+            }
+            CHECK(threw);
+            CHECK_FALSE(*std::ranges::begin(changed | sph::views::hash_verify<sph::hash_algorithm::sha256>(24)));
+        }
+    }
+    SUBCASE("verify.result")
+    {
+        bool verified{ false };
+        auto const payload = appended
+            | sph::views::hash_verify_payload<sph::hash_algorithm::sha256>(24).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK(payload == message);
+        CHECK(verified);
+        auto changed{ appended };
+        changed[10] ^= 0x01;
+        auto const changed_payload = changed
+            | sph::views::hash_verify_payload<sph::hash_algorithm::sha256>(24).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK(changed_payload.size() == message.size());
+        CHECK_FALSE(verified);
+        std::vector<uint8_t> const truncated{ 1, 2, 3 };
+        verified = true;
+        CHECK((truncated | sph::views::hash_verify_payload<sph::hash_algorithm::sha256>(24).with_verify_result(verified) | std::ranges::to<std::vector>()).empty());
+        CHECK_FALSE(verified);
+    }
+    SUBCASE("unfinished.not.verified")
+    {
+        bool verified{ true };
+        auto view = appended | sph::views::hash_verify_payload<sph::hash_algorithm::sha256>(24).with_verify_result(verified);
+        auto it = std::ranges::begin(view);
+        ++it;
+        CHECK(*it == message[1]);
+        CHECK_FALSE(verified);
+    }
+    SUBCASE("padded.and.text")
+    {
+        std::vector<uint32_t> const words{ 1, 2, 3, 4, 5, 6, 7 };
+        auto const padded = words
+            | sph::views::hash<sph::hash_algorithm::blake2b, uint32_t, sph::hash_format::padded, sph::hash_site::append>(23)
+            | std::ranges::to<std::vector>();
+        CHECK((padded | sph::views::hash_verify_payload<sph::hash_algorithm::blake2b, sph::hash_format::padded>(23) | std::ranges::to<std::vector>()) == words);
+        std::string const text{ "hello world" };
+        auto const hex = text
+            | sph::views::hash<sph::hash_algorithm::sha256, char, sph::hash_format::hex, sph::hash_site::append>()
+            | std::ranges::to<std::string>();
+        CHECK((hex | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_format::hex>() | std::ranges::to<std::string>()) == text);
+    }
+    SUBCASE("keyed")
+    {
+        std::array<uint8_t, 16> const key{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        auto const parameters{ sph::blake2b_parameters{ .key = key } };
+        auto const tagged = message
+            | sph::views::hash<sph::hash_algorithm::blake2b, sph::hash_site::append>(16).with_blake2b_parameters(parameters)
+            | std::ranges::to<std::vector>();
+        bool verified{ false };
+        auto const payload = tagged
+            | sph::views::hash_verify_payload<sph::hash_algorithm::blake2b>(16).with_blake2b_parameters(parameters).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK(payload == message);
+        CHECK(verified);
+        auto const unkeyed = tagged
+            | sph::views::hash_verify_payload<sph::hash_algorithm::blake2b>(16).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK(unkeyed == message);
+        CHECK_FALSE(verified);
+    }
+}
+
+TEST_CASE("hash.prepend")
+{
+    std::vector<uint8_t> message(1000);
+    for (size_t i = 0; i < message.size(); ++i)
+    {
+        message[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    auto const prepended = message
+        | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_site::prepend>(24)
+        | std::ranges::to<std::vector>();
+    SUBCASE("hash.then.input")
+    {
+        auto expected = message
+            | sph::views::hash<sph::hash_algorithm::sha256>(24)
+            | std::ranges::to<std::vector>();
+        expected.insert(expected.end(), message.begin(), message.end());
+        CHECK(prepended == expected);
+        std::deque<uint8_t> const queued(message.begin(), message.end());
+        CHECK((queued | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_site::prepend>(24) | std::ranges::to<std::vector>()) == expected);
+    }
+    SUBCASE("verify")
+    {
+        CHECK(*std::ranges::begin(prepended | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_site::prepend>(24)));
+        for (size_t position : std::array<size_t, 3>{ 0, 24, prepended.size() - 1 })
+        {
+            auto changed{ prepended };
+            changed[position] ^= 0x01;
+            CHECK_FALSE(*std::ranges::begin(changed | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_site::prepend>(24)));
+        }
+        std::vector<uint8_t> const truncated{ 1, 2, 3 };
+        CHECK_FALSE(*std::ranges::begin(truncated | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_site::prepend>(24)));
+    }
+    SUBCASE("payload")
+    {
+        bool verified{ false };
+        auto const payload = prepended
+            | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_site::prepend>(24).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK(payload == message);
+        CHECK(verified);
+        auto changed{ prepended };
+        changed[3] ^= 0x01;
+        bool threw{ false };
+        try
+        {
+            auto unused = changed
+                | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_site::prepend>(24)
+                | std::ranges::to<std::vector>();
+            (void)unused;
+        }
+        catch (std::runtime_error const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+    SUBCASE("padded.and.text")
+    {
+        std::vector<uint32_t> const words{ 1, 2, 3, 4, 5, 6, 7 };
+        auto const padded = words
+            | sph::views::hash<sph::hash_algorithm::blake2b, uint32_t, sph::hash_format::padded, sph::hash_site::prepend>(23)
+            | std::ranges::to<std::vector>();
+        CHECK(*std::ranges::begin(padded | sph::views::hash_verify<sph::hash_algorithm::blake2b, sph::hash_site::prepend>(23)));
+        CHECK((padded | sph::views::hash_verify_payload<sph::hash_algorithm::blake2b, sph::hash_format::padded, sph::hash_site::prepend>(23) | std::ranges::to<std::vector>()) == words);
+        std::string const text{ "hello world" };
+        auto const hex = text
+            | sph::views::hash<sph::hash_algorithm::sha256, char, sph::hash_format::hex, sph::hash_site::prepend>()
+            | std::ranges::to<std::string>();
+        CHECK(hex.ends_with(text));
+        CHECK(*std::ranges::begin(hex | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_format::hex, sph::hash_site::prepend>()));
+    }
+    SUBCASE("git.object")
+    {
+        auto const object = message
+            | sph::views::hash<sph::hash_algorithm::git_sha1, sph::hash_site::prepend>()
+            | std::ranges::to<std::vector>();
+        CHECK(*std::ranges::begin(object | sph::views::hash_verify<sph::hash_algorithm::git_sha1, sph::hash_site::prepend>()));
+        CHECK((object | sph::views::hash_verify_payload<sph::hash_algorithm::git_sha1, sph::hash_site::prepend>() | std::ranges::to<std::vector>()) == message);
+    }
+}
+
+TEST_CASE("hash.interleave")
+{
+    std::vector<uint8_t> message(1000);
+    for (size_t i = 0; i < message.size(); ++i)
+    {
+        message[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    auto const chained{ sph::interleave_parameters{ .block_size = 64 } };
+    auto const independent{ sph::interleave_parameters{ .block_size = 64, .chained = false } };
+    auto const interleaved = message
+        | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_site::interleave>(16).with_interleave_parameters(chained)
+        | std::ranges::to<std::vector>();
+    SUBCASE("layout")
+    {
+        std::vector<uint8_t> expected;
+        std::vector<uint8_t> previous;
+        for (size_t offset = 0; offset <= message.size(); offset += 64)
+        {
+            auto const block{ std::span<uint8_t const>{ message }.subspan(offset, std::min<size_t>(64, message.size() - offset)) };
+            auto hashed{ previous };
+            hashed.insert(hashed.end(), block.begin(), block.end());
+            previous = hashed | sph::views::hash<sph::hash_algorithm::sha256>(16) | std::ranges::to<std::vector>();
+            expected.insert(expected.end(), block.begin(), block.end());
+            expected.insert(expected.end(), previous.begin(), previous.end());
+        }
+
+        CHECK(interleaved == expected);
+        auto const unchained = message
+            | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_site::interleave>(16).with_interleave_parameters(independent)
+            | std::ranges::to<std::vector>();
+        CHECK(unchained.size() == interleaved.size());
+        CHECK(std::ranges::equal(std::span{ unchained }.first(80), std::span{ interleaved }.first(80)));
+        CHECK(unchained != interleaved);
+    }
+    SUBCASE("payload")
+    {
+        bool verified{ false };
+        std::deque<uint8_t> const queued(interleaved.begin(), interleaved.end());
+        auto const payload = queued
+            | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_site::interleave>(16).with_interleave_parameters(chained).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK(payload == message);
+        CHECK(verified);
+    }
+    SUBCASE("stops.at.bad.block")
+    {
+        auto changed{ interleaved };
+        changed[(80 * 3) + 5] ^= 0x01;
+        std::vector<uint8_t> payload;
+        bool threw{ false };
+        try
+        {
+            for (auto v : changed | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_site::interleave>(16).with_interleave_parameters(chained))
+            {
+                payload.push_back(v);
+            }
+        }
+        catch (std::runtime_error const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(payload.size() == 64 * 3);
+        bool verified{ true };
+        auto const flagged = changed
+            | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_site::interleave>(16).with_interleave_parameters(chained).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK(flagged.size() == 64 * 3);
+        CHECK_FALSE(verified);
+    }
+    SUBCASE("dropped.and.truncated")
+    {
+        auto dropped{ interleaved };
+        dropped.erase(dropped.begin() + 80, dropped.begin() + 160);
+        bool verified{ true };
+        auto unused = dropped
+            | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_site::interleave>(16).with_interleave_parameters(chained).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK_FALSE(verified);
+        std::vector<uint8_t> const truncated(interleaved.begin(), interleaved.begin() + 160);
+        verified = true;
+        unused = truncated
+            | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_site::interleave>(16).with_interleave_parameters(chained).with_verify_result(verified)
+            | std::ranges::to<std::vector>();
+        CHECK(unused.size() == 128);
+        CHECK_FALSE(verified);
+    }
+    SUBCASE("padded.and.text")
+    {
+        auto const words_interleave{ sph::interleave_parameters{ .block_size = 8 } };
+        std::vector<uint32_t> const words{ 1, 2, 3, 4, 5, 6, 7 };
+        auto const padded = words
+            | sph::views::hash<sph::hash_algorithm::blake2b, uint32_t, sph::hash_format::padded, sph::hash_site::interleave>(23).with_interleave_parameters(words_interleave)
+            | std::ranges::to<std::vector>();
+        CHECK((padded | sph::views::hash_verify_payload<sph::hash_algorithm::blake2b, sph::hash_format::padded, sph::hash_site::interleave>(23).with_interleave_parameters(words_interleave) | std::ranges::to<std::vector>()) == words);
+        std::string const text{ "hello world" };
+        auto const hex = text
+            | sph::views::hash<sph::hash_algorithm::sha256, char, sph::hash_format::hex, sph::hash_site::interleave>().with_interleave_parameters(independent)
+            | std::ranges::to<std::string>();
+        CHECK((hex | sph::views::hash_verify_payload<sph::hash_algorithm::sha256, sph::hash_format::hex, sph::hash_site::interleave>().with_interleave_parameters(independent) | std::ranges::to<std::string>()) == text);
+    }
+    SUBCASE("bad.block.size")
+    {
+        bool threw{ false };
+        try
+        {
+            auto unused = sph::views::hash<sph::hash_algorithm::sha256, uint32_t, sph::hash_format::padded, sph::hash_site::interleave>()
+                .with_interleave_parameters(sph::interleave_parameters{ .block_size = 6 });
+            (void)unused;
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+TEST_CASE("hash_verify.lazy")
+{
+    std::vector<uint8_t> message(300);
+    for (size_t i = 0; i < message.size(); ++i)
+    {
+        message[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    size_t reads{ 0 };
+    auto const counted{ [&reads](uint8_t v) -> uint8_t { ++reads; return v; } };
+    SUBCASE("separate")
+    {
+        auto const hash = message | sph::views::hash<sph::hash_algorithm::sha256>(24) | std::ranges::to<std::vector>();
+        auto verify = message | std::views::transform(counted) | sph::views::hash_verify<sph::hash_algorithm::sha256>(hash);
+        // begin() caches the result, so only a non-const view has one
+        static_assert(!std::ranges::range<decltype(verify) const>);
+        CHECK(reads == 0);
+        CHECK(*std::ranges::begin(verify));
+        CHECK(reads == message.size());
+        CHECK(*std::ranges::begin(verify));
+        CHECK(reads == message.size());
+    }
+    SUBCASE("appended")
+    {
+        auto const appended = message
+            | sph::views::hash<sph::hash_algorithm::sha256, sph::hash_site::append>(24)
+            | std::ranges::to<std::vector>();
+        auto verify = appended | std::views::transform(counted) | sph::views::hash_verify<sph::hash_algorithm::sha256, sph::hash_site::append>(24);
+        CHECK(reads == 0);
+        CHECK(*std::ranges::begin(verify));
+        CHECK(reads == appended.size());
+        CHECK(*std::ranges::begin(verify));
+        CHECK(reads == appended.size());
+    }
+}
+
 TEST_CASE("hash_verify.padding_rejection")
 {
     std::vector<uint8_t> const input{ 'p', 'a', 'd', 'd', 'e', 'd' };